@@ -0,0 +1,21 @@
+#pragma once
+
+#include "dev/devbuild.h"
+
+namespace bn
+{
+class dp_direct_bitmap_bg_painter;
+}
+
+namespace jb::dev
+{
+
+/// @brief Paints the back page with `bn::dp_direct_bitmap_bg_painter`, `sys::bitmap_kernels`,
+/// DMA3 and `CpuFastSet`, and logs the ticks each one took.
+///
+/// Only the first call benches, as the results don't change.
+/// Call site should be guarded with `if constexpr (JB_DEVBUILD)`,
+/// and the back page should be redrawn afterwards.
+void bench_bitmap_kernels(bn::dp_direct_bitmap_bg_painter&);
+
+} // namespace jb::dev
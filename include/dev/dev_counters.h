@@ -0,0 +1,37 @@
+#pragma once
+
+#include "dev/devbuild.h"
+
+#include <cstdint>
+
+namespace jb::dev
+{
+
+/// @brief Counters only collected in the dev build (`JB_DEVBUILD`).
+///
+/// Call sites should be guarded with `if constexpr (JB_DEVBUILD)`,
+/// as these are only defined when `src/dev` is built.
+enum class counter : std::uint8_t
+{
+    SRAM_WRITES,
+    SRAM_SKIPPED_WRITES,
+    SRAM_SKIPPED_BYTES,
+    TEXT_CACHE_HITS,
+    TEXT_CACHE_MISSES,
+    SCENE_POOL_MAX_USED_BYTES,
+    SPRITE_TILES_FREE,
+    SPRITE_TILES_FREE_BLOCKS,
+    SPRITE_TILES_LARGEST_FREE_BLOCK,
+    PROGRESS_UPDATE_MAX_TICKS,
+
+    MAX_COUNT
+};
+
+void add_counter(counter, int amount = 1);
+void set_counter(counter, int value);
+auto counter_value(counter) -> int;
+
+/// @brief Logs the value of the counter with `BN_LOG`.
+void log_counter(counter);
+
+} // namespace jb::dev
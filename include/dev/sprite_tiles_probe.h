@@ -0,0 +1,15 @@
+#pragma once
+
+#include "dev/devbuild.h"
+
+namespace jb::dev
+{
+
+/// @brief Logs the free sprite tiles, how many free blocks they're split into, and the largest free block.
+///
+/// butano doesn't expose its free blocks, so they're probed by allocating the largest block
+/// that still fits until none does, which is slow.
+/// Call site should be guarded with `if constexpr (JB_DEVBUILD)`.
+void log_sprite_tiles_fragmentation();
+
+} // namespace jb::dev
@@ -2,13 +2,20 @@
 
 #include "scn/scene.h"
 
+#include "sys/bitmap_streamer.h"
+#include "sys/playback_service.h"
+#include "sys/thumbnail_item.h"
 #include "ui/menu_navigator.h"
+#include "ui/playback_progress.h"
 
+#include <bn_color.h>
 #include <bn_dp_direct_bitmap_bg_painter.h>
 #include <bn_optional.h>
 #include <bn_sprite_ptr.h>
 #include <bn_vector.h>
 
+#include <cstdint>
+
 namespace jb::scn
 {
 
@@ -31,9 +38,19 @@ private:
         TUNE_INFO,
     };
 
+    enum class thumbnail_stage : std::uint8_t
+    {
+        NONE,
+        CACHED,
+        CLEAR,
+        BLIT,
+        BORDERS,
+    };
+
 private:
     void play_at_cursor();
     void pause_or_resume();
+    void seek_by(int seconds);
     void stop();
 
 private:
@@ -41,13 +58,25 @@ private:
     void set_cursor_index(unsigned index);
 
 private:
+    void reserve_redraw_thumbnail_bg();
+    void update_thumbnail_bg();
+
+    void reserve_thumbnail_prefetches();
+    void update_thumbnail_prefetch();
+
     void redraw_thumbnail_bg();
+    void redraw_thumbnail_placeholder_bg();
+    void redraw_cached_thumbnail(const sys::thumbnail_item&);
+    void redraw_thumbnail_borders();
+
+    void update_thumbnail_redraw();
+    void step_thumbnail_redraw();
+    bool step_thumbnail_blit();
 
     void redraw_tune_head_texts();
     void redraw_a_texts();
-    void redraw_b_texts();
-    void redraw_start_texts();
-    void redraw_select_texts();
+    void redraw_fixed_texts();
+    void redraw_playlist_texts();
 
     void redraw_tune_list_texts();
 
@@ -56,24 +85,37 @@ private:
     void on_tunes_navigator_activated(unsigned menu_index);
     void on_tunes_navigator_cancelled();
 
+    void on_playback_event(sys::playback_event);
+
 private:
     auto init_tunes_navigator() -> ui::menu_navigator;
 
 private:
+    // B, START and SELECT texts, which only change with `_state`.
+    sized_scene_arena<6> _fixed_texts_arena;
+
     state _state = state::TUNE_LIST;
 
     bn::optional<unsigned> _playing_index;
+    sys::playback_service::observer_t _playback_observer;
+    bool _covered = false;
 
     bn::optional<bn::dp_direct_bitmap_bg_painter> _bg_painter;
+    std::uint8_t _thumbnail_dwell_frames_left = 0;
+    bool _thumbnail_placeholder_shown = false;
 
+    thumbnail_stage _thumbnail_stage = thumbnail_stage::NONE;
+    std::uint8_t _thumbnail_stage_row = 0;
+    bn::color _thumbnail_clear_color;
+    bn::optional<sys::thumbnail_item> _thumbnail_cached_item;
+    bn::optional<sys::bitmap_streamer> _thumbnail_streamer;
+
+    // Texts out of the arena, as each of them is redrawn on its own.
     bn::vector<bn::sprite_ptr, 24> _tune_head_text_sprites;
     bn::vector<bn::sprite_ptr, 2> _a_text_sprites;
-    bn::vector<bn::sprite_ptr, 2> _b_text_sprites;
-    bn::vector<bn::sprite_ptr, 2> _start_text_sprites;
-    bn::vector<bn::sprite_ptr, 2> _select_text_sprites;
-
-    bn::vector<bn::sprite_ptr, 96> _list_text_sprites;
+    bn::vector<bn::sprite_ptr, 4> _playlist_text_sprites;
 
+    ui::playback_progress _progress;
     ui::menu_navigator _tunes_navigator;
 };
 
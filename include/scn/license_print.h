@@ -1,9 +1,11 @@
 #pragma once
 
 #include "scn/scene.h"
+#include "sys/compressed_text.h"
 
-#include <bn_sprite_ptr.h>
-#include <bn_vector.h>
+#include <bn_array.h>
+
+#include <cstdint>
 
 #include "ibn_sprite_text_typewriter.h"
 
@@ -19,10 +21,45 @@ public:
     bool update() override;
 
 private:
-    bn::vector<bn::sprite_ptr, 128> _text_sprites;
+    enum class print_mode : std::uint8_t
+    {
+        /// Prints character by character with `ibn::sprite_text_typewriter`.
+        TYPEWRITER,
+        /// Generates whole lines at once, as many as the frame budget allows.
+        INSTANT,
+    };
+
+private:
+    /// @brief Decompresses the page, which is already wrapped by `misc_writer.py`, and starts printing it.
+    void print_page(int page_idx, print_mode);
+
+    /// @brief Prints the rest of the page in this frame, discarding the typewriter output.
+    void skip_printing();
+
+    /// @brief Generates the next lines of the page.
+    /// @param budgeted Whether to stop once `1 / INSTANT_FRAME_BUDGET_DIVISOR` of a frame is used,
+    /// after generating at least one line.
+    void print_lines(bool budgeted);
+
+    bool page_printed() const;
+
+private:
+    // Page number and text sprites, in that order.
+    sized_scene_arena<128> _sprites_arena;
+
     ibn::sprite_text_typewriter _typewriter;
+    bn::array<char, sys::compressed_text::MAX_BLOCK_BYTES> _page_text;
 
     int _license_idx;
+    int _page_idx = 0;
+
+    int _page_bytes = 0;
+    int _text_mark = 0;
+    print_mode _print_mode = print_mode::TYPEWRITER;
+
+    // `print_mode::INSTANT` progress
+    int _printed_bytes = 0;
+    int _printed_lines = 0;
 };
 
 } // namespace jb::scn
@@ -3,8 +3,6 @@
 #include "scn/scene.h"
 
 #include <bn_array.h>
-#include <bn_sprite_ptr.h>
-#include <bn_vector.h>
 
 #include <cstdint>
 
@@ -19,18 +17,24 @@ public:
     licenses_list(int license_idx, scene_context&);
 
 public:
+    void hibernate() override;
+
+    bool load_step() override;
     bool update() override;
 
 private:
+    void generate_name(int license_idx);
+
     void move_cursor_idx(int diff);
 
     void recolor_license(int license_idx);
 
 private:
-    bn::vector<bn::sprite_ptr, 128> _names_sprites;
+    sized_scene_arena<128> _names_arena;
     bn::array<std::uint8_t, gen::LICENSE_NAMES.size() + 1> _name_start_idxes;
 
     int _cursor_idx;
+    int _generated_names_count = 0;
 };
 
 } // namespace jb::scn
@@ -1,5 +1,7 @@
 #pragma once
 
+#include "scn/scene_arena.h"
+
 #include <bn_type_id.h>
 
 namespace jb::scn
@@ -10,12 +12,16 @@ class scene_context;
 
 class scene
 {
+    friend class scene_stack;
+
 public:
     /// @brief Virtual destructor.
     virtual ~scene() = default;
 
     /// @brief Constructor.
-    scene(scene_context& ctx) : _ctx(ctx)
+    /// @param arena Sprites arena of the derived scene, usually a `sized_scene_arena` member of it.
+    /// It's not constructed yet here, so it's only bound.
+    scene(scene_context& ctx, scene_arena& arena) : _ctx(ctx), _arena(arena)
     {
     }
 
@@ -30,6 +36,23 @@ public:
     /// @brief Callback to be called when the upper scene has been removed, thus this scene became top once again.
     virtual void uncover() {};
 
+    /// @brief Callback to be called when the scene has been removed from the stack, but retained to be resumed later.
+    /// The scene should release its rendered resources to free VRAM for the next scene,
+    /// and rewind `load_step()` to rebuild them.
+    /// When it's resumed, it goes through `load_step()` again instead of constructing a new scene.
+    virtual void hibernate() {};
+
+    /// @brief Steps the staged loader of the scene, before it becomes top.
+    ///
+    /// `scene_stack` calls this over several frames under a cycle budget, right after the construction or the resume,
+    /// and the scene becomes top only when it returns `true`.
+    /// Meanwhile, no scene is updated, and what's left on screen (e.g. an `ibn::transitions` fade) stays there.
+    /// @return `true` if the scene is fully loaded.
+    virtual bool load_step()
+    {
+        return true;
+    }
+
 public:
     /// @brief Updates the scene.
     /// @return `true` if `update()` should be called for the next scene below the stack.
@@ -46,8 +69,20 @@ protected:
         return _ctx;
     }
 
+    /// @brief Arena to group the scene-local sprites, which `scene_stack` releases in bulk on pop or replace.
+    auto arena() -> scene_arena&
+    {
+        return _arena;
+    }
+
+    auto arena() const -> const scene_arena&
+    {
+        return _arena;
+    }
+
 private:
     scene_context& _ctx;
+    scene_arena& _arena;
 };
 
 } // namespace jb::scn
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <bn_sprite_ptr.h>
+#include <bn_vector.h>
+
+namespace jb::scn
+{
+
+/// @brief Scene-scoped arena of the sprites, whose tiles and palettes are allocated by butano.
+///
+/// Scene-local sprites are grouped here, and released in bulk when the scene is popped, replaced or hibernated.
+/// Only the sprites that are redrawn together fit in it, as it's released from the end with `release_to()`:
+/// a scene keeps the sprites it redraws on their own, e.g. the texts of the playing tune, in its own vectors.
+/// Storage is owned by `sized_scene_arena`, so that each scene only pays for the sprites it uses.
+class scene_arena
+{
+public:
+    scene_arena(const scene_arena&) = delete;
+    scene_arena& operator=(const scene_arena&) = delete;
+
+public:
+    /// @brief Output vector to allocate the sprites into, e.g. for the text generators.
+    auto sprites() -> bn::ivector<bn::sprite_ptr>&;
+    auto sprites() const -> const bn::ivector<bn::sprite_ptr>&;
+
+    /// @brief Returns a mark to release the sprites allocated after it with `release_to()`.
+    int mark() const;
+
+    /// @brief Releases the sprites allocated after the mark.
+    void release_to(int mark);
+
+    /// @brief Releases all the sprites.
+    void release();
+
+protected:
+    scene_arena(bn::ivector<bn::sprite_ptr>& sprites) : _sprites(sprites)
+    {
+    }
+
+    ~scene_arena() = default;
+
+private:
+    bn::ivector<bn::sprite_ptr>& _sprites;
+};
+
+/// @brief `scene_arena` with the storage for up to `MaxSprites` sprites.
+template <int MaxSprites>
+class sized_scene_arena final : public scene_arena
+{
+public:
+    sized_scene_arena() : scene_arena(_sprites_storage)
+    {
+    }
+
+private:
+    bn::vector<bn::sprite_ptr, MaxSprites> _sprites_storage;
+};
+
+} // namespace jb::scn
@@ -1,16 +1,22 @@
 #pragma once
 
 #include "sys/config_save.h"
+#include "sys/bitmap_streamer.h"
+#include "sys/playback_service.h"
+#include "sys/playlist.h"
 #include "sys/text_generators.h"
+#include "sys/text_sprite_cache.h"
+#include "sys/thumbnail_cache.h"
 
 #include "ibn_observer.h"
 #include "ibn_transitions.h"
 
 #include <bn_array.h>
-#include <bn_bitmap_bg.h>
 #include <bn_color.h>
 #include <bn_span.h>
 
+#include <cstdint>
+
 namespace jb::scn
 {
 
@@ -19,7 +25,7 @@ class scene_stack;
 class scene_context final
 {
 public:
-    scene_context(scene_stack& st) : _scene_stack(st)
+    scene_context(scene_stack& st) : _scene_stack(st), _playlist(_playback, _config_save)
     {
     }
 
@@ -30,11 +36,14 @@ private:
     scene_stack& _scene_stack;
 
     sys::config_save _config_save;
+    sys::playback_service _playback;
+    sys::playlist _playlist;
     ibn::transitions _transitions;
     sys::text_generators _text_generators;
+    sys::text_sprite_cache _text_sprite_cache;
 
-    bn::array<bn::color, bn::bitmap_bg::dp_direct_height() * bn::bitmap_bg::dp_direct_height()>
-        _decompressed_bitmap_bg_colors;
+    alignas(bn::color) bn::array<std::uint8_t, sys::bitmap_streamer::BUFFER_BYTES> _bitmap_stream_buffer;
+    sys::thumbnail_cache _thumbnail_cache;
 
 public:
     auto stack() -> decltype((_scene_stack))
@@ -57,6 +66,26 @@ public:
         return _config_save;
     }
 
+    auto playback() -> decltype((_playback))
+    {
+        return _playback;
+    }
+
+    auto playback() const -> decltype((_playback))
+    {
+        return _playback;
+    }
+
+    auto playlist() -> decltype((_playlist))
+    {
+        return _playlist;
+    }
+
+    auto playlist() const -> decltype((_playlist))
+    {
+        return _playlist;
+    }
+
     auto transitions() -> decltype((_transitions))
     {
         return _transitions;
@@ -77,14 +106,34 @@ public:
         return _text_generators;
     }
 
-    auto decompressed_bitmap_bg_colors() -> bn::span<bn::color>
+    auto text_sprite_cache() -> decltype((_text_sprite_cache))
+    {
+        return _text_sprite_cache;
+    }
+
+    auto text_sprite_cache() const -> decltype((_text_sprite_cache))
+    {
+        return _text_sprite_cache;
+    }
+
+    auto bitmap_stream_buffer() -> bn::span<std::uint8_t>
+    {
+        return _bitmap_stream_buffer;
+    }
+
+    auto bitmap_stream_buffer() const -> bn::span<const std::uint8_t>
+    {
+        return _bitmap_stream_buffer;
+    }
+
+    auto thumbnail_cache() -> decltype((_thumbnail_cache))
     {
-        return _decompressed_bitmap_bg_colors;
+        return _thumbnail_cache;
     }
 
-    auto decompressed_bitmap_bg_colors() const -> bn::span<const bn::color>
+    auto thumbnail_cache() const -> decltype((_thumbnail_cache))
     {
-        return _decompressed_bitmap_bg_colors;
+        return _thumbnail_cache;
     }
 };
 
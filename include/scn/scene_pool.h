@@ -0,0 +1,90 @@
+#pragma once
+
+#include "scn/scene.h"
+#include "scn/scenes.h"
+
+#include <bn_array.h>
+
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <utility>
+
+namespace jb::scn
+{
+
+/// @brief Scene allocator with the size classes of `SCENE_SIZE_CLASSES`.
+///
+/// A scene takes the smallest free slot that fits it, so small scenes don't take slots as large as the biggest scene.
+/// It also tracks the high-water mark of each size class, to tune their slots count.
+class scene_pool final
+{
+public:
+    static constexpr int SIZE_CLASSES_COUNT = SCENE_SIZE_CLASSES.size();
+
+    static constexpr int SLOTS_COUNT = [] {
+        int result = 0;
+        for (const scene_size_class& size_class : SCENE_SIZE_CLASSES)
+            result += size_class.slots_count;
+        return result;
+    }();
+
+    static constexpr int BUFFER_BYTES = [] {
+        int result = 0;
+        for (const scene_size_class& size_class : SCENE_SIZE_CLASSES)
+            result += (size_class.bytes + MAX_SCENE_ALIGN - 1) / MAX_SCENE_ALIGN * MAX_SCENE_ALIGN *
+                      size_class.slots_count;
+        return result;
+    }();
+
+public:
+    scene_pool();
+
+    scene_pool(const scene_pool&) = delete;
+    scene_pool& operator=(const scene_pool&) = delete;
+
+public:
+    template <std::derived_from<scene> Scene, typename... Args>
+    auto create(Args&&... args) -> Scene&
+    {
+        static_assert(alignof(Scene) <= MAX_SCENE_ALIGN, "Scene is not in `scenes.h`");
+
+        std::byte* storage = allocate(sizeof(Scene));
+        return *::new (storage) Scene(std::forward<Args>(args)...);
+    }
+
+    void destroy(scene&);
+
+public:
+    /// @brief Bytes taken by the live scenes, not counting the unused tail of their slots.
+    int used_bytes() const;
+    int max_used_bytes() const;
+
+    int used_slots(int size_class_idx) const;
+    int max_used_slots(int size_class_idx) const;
+
+private:
+    auto allocate(int bytes) -> std::byte*;
+
+private:
+    struct slot final
+    {
+        int offset;
+        int bytes;
+        std::uint8_t size_class_idx;
+        /// `0` if the slot is free.
+        int scene_bytes;
+    };
+
+private:
+    alignas(MAX_SCENE_ALIGN) std::byte _buffer[BUFFER_BYTES];
+    bn::array<slot, SLOTS_COUNT> _slots;
+
+    bn::array<int, SIZE_CLASSES_COUNT> _used_slots{};
+    bn::array<int, SIZE_CLASSES_COUNT> _max_used_slots{};
+    int _used_bytes = 0;
+    int _max_used_bytes = 0;
+};
+
+} // namespace jb::scn
@@ -1,8 +1,7 @@
 #pragma once
 
-#include "scn/scenes.h"
+#include "scn/scene_pool.h"
 
-#include <bn_generic_pool.h>
 #include <bn_unique_ptr.h>
 
 namespace jb::scn
@@ -10,20 +9,23 @@ namespace jb::scn
 
 class scene;
 
+/// @brief Max depth of the scene stack.
 inline constexpr int MAX_SCENE_COUNT = 2;
+inline constexpr int MAX_HIBERNATED_SCENE_COUNT = 1;
 
-using scene_pool_t = bn::generic_pool<MAX_SCENE_SIZE, MAX_SCENE_COUNT, MAX_SCENE_ALIGN>;
+static_assert(scene_pool::SLOTS_COUNT >= MAX_SCENE_COUNT + MAX_HIBERNATED_SCENE_COUNT,
+              "Not enough slots in SCENE_SIZE_CLASSES");
 
 class scene_deleter final
 {
 public:
     scene_deleter() = default;
-    scene_deleter(scene_pool_t&);
+    scene_deleter(scene_pool&);
 
     void operator()(scene*) const;
 
 private:
-    scene_pool_t* _pool = nullptr;
+    scene_pool* _pool = nullptr;
 };
 
 using scene_ptr = bn::unique_ptr<scene, scene_deleter>;
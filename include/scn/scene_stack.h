@@ -4,7 +4,6 @@
 
 #include "ibn_function.h"
 
-#include <bn_generic_pool.h>
 #include <bn_vector.h>
 
 #include <concepts>
@@ -27,6 +26,10 @@ public:
     /// This should be called each frame.
     void update();
 
+    /// @brief Whether a new scene is being loaded with `scene::load_step()`.
+    /// Scenes aren't updated, and reserved changes are postponed until it's loaded.
+    bool loading() const;
+
 private:
     template <typename T>
     struct wrapped_value final
@@ -41,6 +44,7 @@ private:
             PUSH,
             POP,
             REPLACE_TOP,
+            HIBERNATE_REPLACE_TOP,
             CLEAR,
         };
 
@@ -48,15 +52,22 @@ private:
 
         kind change_kind;
         bool delay_frame;
+        bool resume_hibernated;
         bn::type_id_t new_scene_type;
         new_scene_factory_t new_scene_factory;
     };
 
+    struct scene_entry final
+    {
+        bn::type_id_t type;
+        scene_ptr ptr;
+    };
+
     template <std::derived_from<scene> Scene, typename... Args>
-    void reserve_add_impl(reserved_change::kind change_kind, bool delay_frame, Args&&... args)
+    void reserve_add_impl(reserved_change::kind change_kind, bool delay_frame, bool resume_hibernated, Args&&... args)
     {
         _reserved_changes.emplace_back(
-            change_kind, delay_frame, bn::type_id<Scene>(),
+            change_kind, delay_frame, resume_hibernated, bn::type_id<Scene>(),
             [... args = wrapped_value<Args>{std::forward<Args>(args)}](scene_stack& self) mutable {
                 return scene_ptr(&self._scene_pool.create<Scene>(std::forward<Args>(args.value)...),
                                  scene_deleter(self._scene_pool));
@@ -67,12 +78,14 @@ public:
     /// @brief Reserves push of a new scene, with given constructor arguments.
     ///
     /// Calls `scene::cover()` first for the previous top scene, and constructs a new scene afterwards.
+    /// @note If a scene of the same type is hibernated, it's destroyed, as it'd be stale to resume later.
+    /// This applies to `reserve_replace_top()` and such, too.
     /// @note If you want to delay a frame between `scene::cover()` and scene construction,
     /// use `reserve_push_with_delay()` instead.
     template <std::derived_from<scene> Scene, typename... Args>
     void reserve_push(Args&&... args)
     {
-        reserve_add_impl<Scene>(reserved_change::kind::PUSH, false, std::forward<Args>(args)...);
+        reserve_add_impl<Scene>(reserved_change::kind::PUSH, false, false, std::forward<Args>(args)...);
     }
 
     /// @brief Reserves push of a new scene, with given constructor arguments.
@@ -83,7 +96,7 @@ public:
     template <std::derived_from<scene> Scene, typename... Args>
     void reserve_push_with_delay(Args&&... args)
     {
-        reserve_add_impl<Scene>(reserved_change::kind::PUSH, true, std::forward<Args>(args)...);
+        reserve_add_impl<Scene>(reserved_change::kind::PUSH, true, false, std::forward<Args>(args)...);
     }
 
     /// @brief Reserves replace of the top scene with a new scene, with given constructor arguments.
@@ -94,7 +107,7 @@ public:
     template <std::derived_from<scene> Scene, typename... Args>
     void reserve_replace_top(Args&&... args)
     {
-        reserve_add_impl<Scene>(reserved_change::kind::REPLACE_TOP, false, std::forward<Args>(args)...);
+        reserve_add_impl<Scene>(reserved_change::kind::REPLACE_TOP, false, false, std::forward<Args>(args)...);
     }
 
     /// @brief Reserves replace of the top scene with a new scene, with given constructor arguments.
@@ -105,7 +118,45 @@ public:
     template <std::derived_from<scene> Scene, typename... Args>
     void reserve_replace_top_with_delay(Args&&... args)
     {
-        reserve_add_impl<Scene>(reserved_change::kind::REPLACE_TOP, true, std::forward<Args>(args)...);
+        reserve_add_impl<Scene>(reserved_change::kind::REPLACE_TOP, true, false, std::forward<Args>(args)...);
+    }
+
+    /// @brief Reserves replace of the top scene with a new scene, with given constructor arguments.
+    ///
+    /// Hibernates previous top scene first with `scene::hibernate()` instead of destroying it,
+    /// and constructs a new scene afterwards.
+    /// Hibernated scene is resumed with `reserve_resume_replace_top()` later.
+    /// If there are already `MAX_HIBERNATED_SCENE_COUNT` hibernated scenes, the oldest one is destroyed.
+    template <std::derived_from<scene> Scene, typename... Args>
+    void reserve_hibernate_replace_top(Args&&... args)
+    {
+        reserve_add_impl<Scene>(reserved_change::kind::HIBERNATE_REPLACE_TOP, false, false,
+                                std::forward<Args>(args)...);
+    }
+
+    /// @brief Reserves replace of the top scene with the hibernated scene of the type.
+    ///
+    /// Destroys previous top scene first, and resumes the hibernated scene with `scene::load_step()` afterwards.
+    /// If there's none, a new scene is constructed with given constructor arguments instead.
+    /// @note If you want to delay a frame between scene destruction and resume,
+    /// use `reserve_resume_replace_top_with_delay()` instead.
+    template <std::derived_from<scene> Scene, typename... Args>
+    void reserve_resume_replace_top(Args&&... args)
+    {
+        reserve_add_impl<Scene>(reserved_change::kind::REPLACE_TOP, false, true, std::forward<Args>(args)...);
+    }
+
+    /// @brief Reserves replace of the top scene with the hibernated scene of the type.
+    ///
+    /// Destroys previous top scene first, delays a frame,
+    /// and resumes the hibernated scene with `scene::load_step()` afterwards.
+    /// If there's none, a new scene is constructed with given constructor arguments instead.
+    /// @note If you don't want to delay a frame between scene destruction and resume,
+    /// use `reserve_resume_replace_top()` instead.
+    template <std::derived_from<scene> Scene, typename... Args>
+    void reserve_resume_replace_top_with_delay(Args&&... args)
+    {
+        reserve_add_impl<Scene>(reserved_change::kind::REPLACE_TOP, true, true, std::forward<Args>(args)...);
     }
 
     /// @brief Reserves pop of the top scene.
@@ -123,12 +174,25 @@ public:
     /// use `reserve_pop()` instead.
     void reserve_pop_with_delay();
 
-    /// @brief Reserves clearing all the scenes in the stack.
+    /// @brief Reserves clearing all the scenes in the stack, including the hibernated ones.
     void reserve_clear();
 
 private:
-    scene_pool_t _scene_pool;
-    bn::vector<scene_ptr, MAX_SCENE_COUNT> _scenes;
+    /// @brief Loads the hibernated scene of the new scene type again if it's requested,
+    /// or constructs a new scene otherwise.
+    void push_new_or_resumed(reserved_change&);
+
+    /// @brief Steps the loading scene under the frame budget, and pushes it once it's loaded.
+    void step_loading();
+
+    /// @brief Releases the scene arena in bulk, and destroys the scene.
+    void destroy_scene(scene_entry&);
+
+private:
+    scene_pool _scene_pool;
+    bn::vector<scene_entry, MAX_SCENE_COUNT> _scenes;
+    bn::vector<scene_entry, MAX_HIBERNATED_SCENE_COUNT> _hibernated_scenes;
+    scene_entry _loading_scene;
 
     bn::vector<reserved_change, MAX_SCENE_COUNT> _reserved_changes;
 };
@@ -4,16 +4,27 @@
 #include "scn/license_print.h"
 #include "scn/licenses_list.h"
 
+#include <bn_array.h>
+
 #include <algorithm>
 
 namespace jb::scn
 {
 
-inline constexpr int MAX_SCENE_SIZE = std::max({
-    sizeof(jukebox),
-    sizeof(licenses_list),
-    sizeof(license_print),
-});
+struct scene_size_class final
+{
+    int bytes;
+    int slots_count;
+};
+
+/// @brief Size classes of `scene_pool`.
+///
+/// Slots should cover the deepest scene stack with its hibernated scenes,
+/// e.g. `jukebox` at the bottom, `license_print` on top of it, and `licenses_list` hibernated.
+inline constexpr bn::array<scene_size_class, 2> SCENE_SIZE_CLASSES = {{
+    {(int)std::max({sizeof(licenses_list), sizeof(license_print)}), 2},
+    {(int)sizeof(jukebox), 1},
+}};
 
 inline constexpr int MAX_SCENE_ALIGN = std::max({
     alignof(jukebox),
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <bn_color.h>
+#include <bn_common.h>
+
+#include <cstdint>
+
+namespace bn
+{
+class dp_direct_bitmap_bg_painter;
+}
+
+namespace jb::sys::bitmap_kernels
+{
+
+/// @brief Gets the back page of the double paged direct bitmap bg, which the painter paints to.
+/// @note Don't paint to it after `flip_page_later()` in the same frame.
+auto dp_back_page(bn::dp_direct_bitmap_bg_painter&) -> std::uint16_t*;
+
+/// @brief Fills a rectangle of the dp direct bitmap page, setting the words of each row with `bn::memory`.
+BN_CODE_IWRAM void fill_rect(std::uint16_t* page, int x, int y, int width, int height, bn::color color);
+
+/// @brief Blits a rectangle of colors to the dp direct bitmap page,
+/// copying the words of each row with `bn::memory` when aligned.
+/// @param src Top-left color to blit.
+/// @param src_stride Number of colors between the rows of `src`.
+BN_CODE_IWRAM void blit_rect(std::uint16_t* page, int x, int y, const bn::color* src, int src_stride, int width,
+                             int height);
+
+/// @brief Blits a rectangle of palette indexes to the dp direct bitmap page, looking up two pixels per 32-bit store.
+/// @param src Top-left palette index to blit.
+/// @param src_stride Number of indexes between the rows of `src`.
+/// @param palette Colors of the palette, which should have every color `src` refers to.
+BN_CODE_IWRAM void blit_indexed_rect(std::uint16_t* page, int x, int y, const std::uint8_t* src, int src_stride,
+                                     const bn::color* palette, int width, int height);
+
+/// @brief Draws a 2 pixels thick frame, with the given outer and inner colors.
+///
+/// Top and bottom are drawn as spans, and each row of the left and right sides as a single 32-bit store.
+/// @note `x` and `width` should be even, so that the sides are word aligned.
+BN_CODE_IWRAM void draw_frame(std::uint16_t* page, int x, int y, int width, int height, bn::color outer,
+                              bn::color inner);
+
+} // namespace jb::sys::bitmap_kernels
@@ -0,0 +1,108 @@
+#pragma once
+
+#include "sys/indexed_bitmap_item.h"
+
+#include <bn_color.h>
+#include <bn_compression_type.h>
+#include <bn_direct_bitmap_item.h>
+#include <bn_size.h>
+#include <bn_span.h>
+
+#include <cstdint>
+
+namespace jb::sys
+{
+
+/// @brief Decompresses a `bn::direct_bitmap_item` or an `indexed_bitmap_item` strip by strip,
+/// so that a buffer for the whole decompressed bitmap isn't needed.
+///
+/// Supports the GBA BIOS compatible LZ77, run-length and Huffman compressions, which butano uses.
+/// Uncompressed bitmaps are streamed without copying.
+class bitmap_streamer final
+{
+public:
+    /// @brief LZ77 refers up to 4 KB behind, so this much decompressed data is kept.
+    static constexpr int WINDOW_BYTES = 4096;
+    static constexpr int STRIP_BYTES = 4096;
+    /// @brief Longest output of a single token, which might overflow the strip.
+    static constexpr int MAX_TOKEN_BYTES = 130;
+
+    static constexpr int BUFFER_BYTES = WINDOW_BYTES + STRIP_BYTES + MAX_TOKEN_BYTES;
+
+public:
+    /// @param buffer Buffer of at least `BUFFER_BYTES`, aligned for `bn::color`.
+    bitmap_streamer(const bn::direct_bitmap_item& item, bn::span<std::uint8_t> buffer);
+
+    /// @param buffer Buffer of at least `BUFFER_BYTES`, aligned for `bn::color`.
+    bitmap_streamer(const indexed_bitmap_item& item, bn::span<std::uint8_t> buffer);
+
+    bitmap_streamer(const bitmap_streamer&) = delete;
+    bitmap_streamer& operator=(const bitmap_streamer&) = delete;
+
+public:
+    auto dimensions() const -> bn::size;
+
+    /// @brief Number of rows already returned by `next_strip()`,
+    /// which is also the y of the next strip.
+    int streamed_rows() const;
+
+    bool done() const;
+
+    bool indexed() const;
+
+    /// @brief Decompresses the next strip of whole rows of the direct bitmap.
+    /// @return Uncompressed strip, which is valid until the next call.
+    auto next_strip() -> bn::direct_bitmap_item;
+
+    /// @brief Decompresses the next strip of whole rows of the direct bitmap, up to `max_rows` rows.
+    /// @return Uncompressed strip, which is valid until the next call.
+    auto next_strip(int max_rows) -> bn::direct_bitmap_item;
+
+    /// @brief Decompresses the next strip of whole rows of the indexed bitmap, up to `max_rows` rows.
+    /// @return Uncompressed strip, which is valid until the next call.
+    auto next_indexed_strip(int max_rows) -> indexed_bitmap_item;
+
+private:
+    bitmap_streamer(const std::uint8_t* src, const bn::size& dimensions, int pixel_bytes,
+                    bn::compression_type compression, bn::span<std::uint8_t> buffer);
+
+    /// @return Uncompressed rows, and its number of rows.
+    auto next_strip_bytes(int max_rows, int& rows) -> const std::uint8_t*;
+
+    void compact();
+    void decode_until(int write_pos);
+
+    void decode_lz77_token();
+    void decode_run_length_token();
+    void decode_huffman_token();
+    auto decode_huffman_symbol() -> std::uint8_t;
+
+    void put_byte(std::uint8_t byte);
+
+private:
+    const bn::size _dimensions;
+    const bn::compression_type _compression;
+    const std::uint8_t _pixel_bytes;
+    const bn::span<std::uint8_t> _buffer;
+
+    /// Palette of the indexed bitmap, which is empty for the direct bitmap.
+    bn::span<const bn::color> _palette;
+
+    const std::uint8_t* _src;
+    int _total_bytes;
+    int _decoded_bytes;
+
+    int _write_pos;
+    int _emit_pos;
+    int _streamed_rows;
+
+    std::uint8_t _lz77_flags;
+    std::uint8_t _lz77_flags_left;
+
+    const std::uint8_t* _huffman_root;
+    std::uint32_t _huffman_word;
+    std::uint8_t _huffman_bits_left;
+    std::uint8_t _huffman_symbol_bits;
+};
+
+} // namespace jb::sys
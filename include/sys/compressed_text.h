@@ -0,0 +1,62 @@
+#pragma once
+
+#include <bn_span.h>
+
+#include <cstdint>
+
+namespace jb::sys
+{
+
+/// @brief UTF-8 text compressed into blocks, which refer to a static dictionary shared between texts.
+///
+/// Each block only refers to the dictionary and itself, so any block can be decompressed on its own,
+/// without decompressing the blocks before it.
+/// Generated by `tools/text_compressor.py`.
+///
+/// Token format:
+/// * `0LLLLLLL`, then `L + 1` literal bytes.
+/// * `1LLLLLLL DDDDDDDD DDDDDDDD`, which copies `L + MIN_MATCH_LENGTH` bytes from `D + 1` (little endian) bytes behind.
+///   Bytes before the block are the end of the dictionary.
+class compressed_text final
+{
+public:
+    static constexpr int MAX_BLOCK_BYTES = 1024;
+    static constexpr int MIN_MATCH_LENGTH = 4;
+
+public:
+    /// @param dictionary_ref Static dictionary shared between texts.
+    /// @param data_ref Compressed blocks.
+    /// @param block_ends_ref End offset of each block in `data_ref`.
+    /// @param size Decompressed size in bytes.
+    constexpr compressed_text(const bn::span<const std::uint8_t>& dictionary_ref,
+                              const bn::span<const std::uint8_t>& data_ref,
+                              const bn::span<const std::uint16_t>& block_ends_ref, int size)
+        : _dictionary_ref(dictionary_ref), _data_ref(data_ref), _block_ends_ref(block_ends_ref), _size(size)
+    {
+    }
+
+public:
+    int blocks_count() const
+    {
+        return _block_ends_ref.size();
+    }
+
+    /// @brief Decompresses a block.
+    /// @param output Buffer of at least `MAX_BLOCK_BYTES`.
+    /// @return Number of decompressed bytes.
+    int decompress_block(int block_idx, bn::span<char> output) const;
+
+private:
+    bn::span<const std::uint8_t> _dictionary_ref;
+    bn::span<const std::uint8_t> _data_ref;
+    bn::span<const std::uint16_t> _block_ends_ref;
+    int _size;
+
+public:
+    constexpr auto size() const -> decltype((_size))
+    {
+        return _size;
+    }
+};
+
+} // namespace jb::sys
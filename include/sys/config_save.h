@@ -1,5 +1,9 @@
 #pragma once
 
+#include "sys/repeat_mode.h"
+
+#include <bn_array.h>
+
 #include <cstdint>
 
 namespace ibn
@@ -14,8 +18,19 @@ class bit_stream_reader;
 namespace jb::sys
 {
 
+/// @brief Config that is saved to SRAM.
+///
+/// Setters only mark the config dirty, and it's written behind to SRAM:
+/// * after the config has been idle for `IDLE_FLUSH_FRAMES`, by `update()`.
+/// * when `flush()` is called, e.g. on scene change and before the music stops.
+///
+/// Either way, it's never written more than `MAX_WRITES_PER_MINUTE` times a minute.
 class config_save final
 {
+public:
+    static constexpr int IDLE_FLUSH_FRAMES = 90;
+    static constexpr int MAX_WRITES_PER_MINUTE = 6;
+
 public:
     config_save();
 
@@ -26,19 +41,63 @@ public:
     void reset();
 
     bool load();
+
+    /// @brief Writes to SRAM immediately, regardless of the dirty state and the writes cap.
     void save();
 
+public:
+    /// @brief Flushes the dirty config if it has been idle long enough.
+    /// This should be called each frame.
+    void update();
+
+    /// @brief Flushes the dirty config right away, unless the writes cap is reached.
+    /// If it's capped, it stays dirty and `update()` retries it later.
+    void flush();
+
+    bool dirty() const;
+
 public:
     unsigned tune_index() const;
     void set_tune_index(unsigned index);
 
+    auto repeat() const -> repeat_mode;
+    void set_repeat(repeat_mode);
+
+    bool shuffle() const;
+    void set_shuffle(bool);
+
+    /// @brief Seed of the shuffled queue, so that the same order is restored on load.
+    auto shuffle_seed() const -> std::uint16_t;
+    void set_shuffle_seed(std::uint16_t);
+
 public: // `sram_rw` uses these to save/load
     void measure(ibn::bit_stream_measurer& measurer) const;
     void write(ibn::bit_stream_writer& writer) const;
     void read(ibn::bit_stream_reader& reader);
 
+private:
+    /// @brief Packs the playlist mode into a byte: repeat mode (2 bits) and shuffle (1 bit).
+    auto playlist_flags() const -> std::uint8_t;
+    void set_playlist_flags(std::uint8_t);
+
+    void mark_dirty(bool changed);
+
+    bool write_allowed() const;
+
 private:
     unsigned _tune_index;
+    repeat_mode _repeat;
+    bool _shuffle;
+    std::uint16_t _shuffle_seed;
+
+    bool _dirty;
+    unsigned _frame;
+    unsigned _changed_frame;
+
+    /// Ring buffer of the frames the last `MAX_WRITES_PER_MINUTE` writes happened.
+    bn::array<unsigned, MAX_WRITES_PER_MINUTE> _write_frames;
+    std::uint8_t _write_frames_head;
+    std::uint8_t _write_frames_count;
 };
 
 } // namespace jb::sys
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <bn_assert.h>
+#include <bn_color.h>
+#include <bn_compression_type.h>
+#include <bn_size.h>
+#include <bn_span.h>
+
+#include <cstdint>
+
+namespace jb::sys
+{
+
+/// @brief 8bpp palettized bitmap, which is half the size of a `bn::direct_bitmap_item` with the same dimensions.
+///
+/// Each byte of the indexes is an index into its own palette of up to 256 colors.
+/// Generated by `tools/thumbnail_writer.py`.
+class indexed_bitmap_item final
+{
+public:
+    static constexpr int MAX_PALETTE_COLORS = 256;
+
+public:
+    /// @param indexes_ref Palette indexes, which are compressed with `compression`.
+    /// @param palette_ref Colors of the palette.
+    /// @param dimensions Width and height in pixels.
+    /// @param compression Compression of the indexes.
+    constexpr indexed_bitmap_item(const bn::span<const std::uint8_t>& indexes_ref,
+                                  const bn::span<const bn::color>& palette_ref, const bn::size& dimensions,
+                                  bn::compression_type compression)
+        : _indexes_ref(indexes_ref), _palette_ref(palette_ref), _dimensions(dimensions), _compression(compression)
+    {
+        BN_ASSERT(dimensions.width() > 0 && dimensions.height() > 0, "Invalid dimensions: ", dimensions.width(),
+                  " - ", dimensions.height());
+        BN_ASSERT(!palette_ref.empty() && palette_ref.size() <= MAX_PALETTE_COLORS,
+                  "Invalid palette colors count: ", palette_ref.size());
+        BN_ASSERT(compression != bn::compression_type::NONE ||
+                      indexes_ref.size() == dimensions.width() * dimensions.height(),
+                  "Invalid indexes count: ", indexes_ref.size());
+    }
+
+private:
+    bn::span<const std::uint8_t> _indexes_ref;
+    bn::span<const bn::color> _palette_ref;
+    bn::size _dimensions;
+    bn::compression_type _compression;
+
+public:
+    constexpr auto indexes_ref() const -> decltype((_indexes_ref))
+    {
+        return _indexes_ref;
+    }
+
+    constexpr auto palette_ref() const -> decltype((_palette_ref))
+    {
+        return _palette_ref;
+    }
+
+    constexpr auto dimensions() const -> decltype((_dimensions))
+    {
+        return _dimensions;
+    }
+
+    constexpr auto compression() const -> decltype((_compression))
+    {
+        return _compression;
+    }
+};
+
+} // namespace jb::sys
@@ -0,0 +1,134 @@
+#pragma once
+
+#include "ibn_observer.h"
+
+#include <bn_fixed.h>
+#include <bn_optional.h>
+#include <bn_vector.h>
+
+#include <cstdint>
+
+namespace bn
+{
+class dmg_music_item;
+}
+
+namespace jb::sys
+{
+
+class tune_metadata;
+
+enum class playback_event : std::uint8_t
+{
+    /// Track has started, including the prepared next track after the end of the previous one.
+    STARTED,
+    STOPPED,
+    PAUSED,
+    RESUMED,
+    /// Track has reached its end, without being stopped.
+    END_OF_TRACK,
+    /// Looping track has jumped back to its loop point.
+    LOOP_POINT,
+};
+
+/// @brief Wraps `bn::dmg_music`, and raises the events when its state changes.
+///
+/// Events are queued as they happen, and dispatched once per frame by `update()` to the subscribed observers,
+/// so that the UI only reacts when the state actually changes, instead of polling it every frame.
+/// An event raised again before it's dispatched is moved to the back of the queue, instead of being queued twice,
+/// so that the observers see the latest order of the state changes.
+///
+/// Next track can be prepared ahead with `prepare_next()`, so that `update()` starts it
+/// without waiting a frame for the observers to react.
+/// `bn::dmg_music` can't queue a track, so the end of a track that doesn't loop is detected by its elapsed ticks
+/// reaching the total ticks of its metadata, and the next track is started in the same frame,
+/// instead of after the engine has stopped.
+class playback_service final
+{
+public:
+    using subject_t = ibn::subject<playback_event>;
+    using observer_t = ibn::observer<playback_event>;
+
+    /// @brief Ticks played per second, which is the frame rate (16777216 / 280896 Hz),
+    /// as `bn::dmg_music` plays a tick each frame, whatever the tick rate of the module is.
+    static constexpr bn::fixed TICKS_PER_SECOND = bn::fixed::from_data(int(16777216LL * 4096 / 280896));
+
+    /// @brief An event is pending only once, so there's room for every kind of them.
+    static constexpr int MAX_PENDING_EVENTS = int(playback_event::LOOP_POINT) + 1;
+
+public:
+    playback_service() = default;
+
+    playback_service(const playback_service&) = delete;
+    playback_service& operator=(const playback_service&) = delete;
+
+public:
+    /// @brief Plays the track, dropping the prepared next track.
+    /// @param metadata Metadata of the track, to detect its end.
+    /// @param track_id Id of the track for the observers, e.g. the tune index.
+    void play(const bn::dmg_music_item&, const tune_metadata& metadata, bn::fixed volume, bool loop, int track_id);
+    void stop();
+    void pause();
+    void resume();
+
+    /// @brief Whether a track is playing, including when it's paused.
+    bool playing() const;
+    bool paused() const;
+
+    /// @brief Id of the current track, or the last one if it's stopped.
+    int track_id() const;
+
+    /// @brief Ticks the current track has played, not counting the paused frames.
+    ///
+    /// It doesn't wrap around on the loop point.
+    /// `bn::dmg_music` is updated once per frame, so this is the frames since the track started.
+    int elapsed_ticks() const;
+
+    /// @brief Jumps to the row played at the `ticks` from the start of the current track.
+    ///
+    /// Row is looked up in the seek points of the metadata, which are analyzed at build time,
+    /// so it takes the same time wherever it seeks to.
+    /// Notes held from the rows before the target aren't restored, so the channels are silent until their next note.
+    void seek(const tune_metadata&, int ticks);
+
+public:
+    /// @brief Prepares the track to play when the current track ends.
+    void prepare_next(const bn::dmg_music_item&, const tune_metadata&, bn::fixed volume, bool loop, int track_id);
+    void clear_next();
+
+public:
+    void subscribe(observer_t&);
+
+    /// @brief Detects the end of track and the loop point, starts the prepared next track on the end,
+    /// and dispatches the pending events.
+    /// This should be called each frame.
+    void update();
+
+private:
+    void end_track();
+    void raise(playback_event);
+
+private:
+    subject_t _subject;
+    bn::vector<playback_event, MAX_PENDING_EVENTS> _pending_events;
+
+    struct track final
+    {
+        const bn::dmg_music_item* item;
+        const tune_metadata* metadata;
+        bn::fixed volume;
+        bool loop;
+        int track_id;
+    };
+
+    bool _playing = false;
+    bool _loop = false;
+    int _last_pattern = 0;
+    int _track_id = -1;
+    int _elapsed_ticks = 0;
+    int _total_ticks = 0;
+
+    bn::optional<track> _next;
+};
+
+} // namespace jb::sys
@@ -0,0 +1,71 @@
+#pragma once
+
+#include "sys/playback_service.h"
+#include "sys/repeat_mode.h"
+
+#include <bn_optional.h>
+#include <bn_vector.h>
+
+#include <cstdint>
+
+namespace jb::sys
+{
+
+class config_save;
+
+/// @brief Queue of the tunes, which prepares the next tune ahead in `playback_service`,
+/// so that it starts as soon as the end of the current tune is detected.
+///
+/// Looping tunes never end on their own, so they only loop on `repeat_mode::ONE`, and play once otherwise.
+/// If the repeat mode is changed while one is looping, the queue advances on its next loop point.
+///
+/// Queue is all the tunes in order, or shuffled with the seed from `config_save`,
+/// so the same order comes back on load.
+/// Repeat mode, shuffle and its seed are persisted in `config_save`.
+class playlist final
+{
+public:
+    static constexpr int MAX_TUNES = 64;
+
+public:
+    playlist(playback_service&, config_save&);
+
+    playlist(const playlist&) = delete;
+    playlist& operator=(const playlist&) = delete;
+
+public:
+    /// @brief Plays the tune, and continues the queue from it.
+    void play(int tune_index);
+
+public:
+    auto repeat() const -> repeat_mode;
+    void set_repeat(repeat_mode);
+
+    bool shuffle() const;
+    /// @brief Turns on or off the shuffle. Each time it's turned on, the queue is shuffled with a new seed.
+    void set_shuffle(bool);
+
+private:
+    void on_playback_event(playback_event);
+
+    /// @brief Moves to the playing tune in the queue, and prepares the next one.
+    void sync_queue();
+    void rebuild_queue();
+    void prepare_next();
+
+    /// @brief Position of the tune after the playing one, or none if the queue ends.
+    auto next_position() const -> bn::optional<int>;
+    bool loops(int tune_index) const;
+
+    auto queue_position(int tune_index) const -> int;
+
+private:
+    playback_service& _playback;
+    config_save& _config_save;
+    playback_service::observer_t _playback_observer;
+
+    bn::vector<std::uint8_t, MAX_TUNES> _queue;
+    int _position = 0;
+};
+
+} // namespace jb::sys
@@ -0,0 +1,18 @@
+#pragma once
+
+#include <cstdint>
+
+namespace jb::sys
+{
+
+enum class repeat_mode : std::uint8_t
+{
+    /// Plays the queue once, and stops after the last tune.
+    OFF,
+    ONE,
+    ALL,
+
+    MAX_COUNT
+};
+
+} // namespace jb::sys
@@ -0,0 +1,84 @@
+#pragma once
+
+#include "sys/text_generators.h"
+
+#include <bn_fixed_point.h>
+#include <bn_span.h>
+#include <bn_sprite_ptr.h>
+#include <bn_sprite_shape_size.h>
+#include <bn_sprite_tiles_ptr.h>
+#include <bn_string_view.h>
+#include <bn_vector.h>
+
+namespace bn
+{
+class sprite_palette_item;
+}
+
+namespace jb::sys
+{
+
+/// @brief LRU cache of rendered text sprite tiles, keyed by (font, text).
+///
+/// Palette isn't a part of the key, as the tiles are the same regardless of it;
+/// sprites are created with the requested palette on a hit.
+///
+/// Cached tiles are kept in VRAM up to `MAX_TILES`, so `clear()` it when VRAM is needed elsewhere.
+/// @note Cached texts are referenced, not copied, so they should outlive the cache entry.
+class text_sprite_cache final
+{
+public:
+    static constexpr int MAX_ENTRIES = 24;
+    static constexpr int MAX_SPRITES_PER_ENTRY = 6;
+    static constexpr int MAX_TILES = 128;
+
+public:
+    text_sprite_cache() = default;
+
+    text_sprite_cache(const text_sprite_cache&) = delete;
+    text_sprite_cache& operator=(const text_sprite_cache&) = delete;
+
+public:
+    /// @brief Creates the sprites of a cached text.
+    /// @return `true` if the text was cached and its sprites are created,
+    /// `false` otherwise, without changing `output_sprites`.
+    bool create_top_left(text_generators::font, const bn::string_view& text, const bn::fixed_point& top_left_position,
+                         const bn::sprite_palette_item&, bn::ivector<bn::sprite_ptr>& output_sprites);
+
+    /// @brief Stores the tiles of the sprites generated for a text.
+    /// Least recently used entries are evicted to keep it under the budget.
+    void store(text_generators::font, const bn::string_view& text, const bn::fixed_point& top_left_position,
+               bn::span<const bn::sprite_ptr> text_sprites);
+
+    void clear();
+
+    int tiles_count() const;
+
+private:
+    struct cached_sprite final
+    {
+        bn::sprite_tiles_ptr tiles;
+        bn::sprite_shape_size shape_size;
+        bn::fixed_point offset;
+    };
+
+    struct entry final
+    {
+        text_generators::font font;
+        bn::string_view text;
+        unsigned last_used;
+        int tiles_count;
+        bn::vector<cached_sprite, MAX_SPRITES_PER_ENTRY> sprites;
+    };
+
+private:
+    auto find(text_generators::font, const bn::string_view& text) -> entry*;
+    void evict_least_recently_used();
+
+private:
+    bn::vector<entry, MAX_ENTRIES> _entries;
+    unsigned _tick = 0;
+    int _tiles_count = 0;
+};
+
+} // namespace jb::sys
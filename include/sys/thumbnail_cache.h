@@ -0,0 +1,90 @@
+#pragma once
+
+#include "sys/bitmap_streamer.h"
+#include "sys/thumbnail_item.h"
+
+#include <bn_array.h>
+#include <bn_bitmap_bg.h>
+#include <bn_color.h>
+#include <bn_optional.h>
+#include <bn_size.h>
+#include <bn_span.h>
+#include <bn_vector.h>
+
+#include <cstdint>
+
+namespace jb::sys
+{
+
+/// @brief Cache of decompressed thumbnails, which are prefetched in idle frames within a cycle budget.
+///
+/// Thumbnails are cropped to the center `MAX_SIZE` x `MAX_SIZE` when cached,
+/// so a cached thumbnail can be blitted as a whole.
+/// Only the indexed thumbnails are cached, as a byte per pixel, and their palettes are referred to as they are.
+/// Direct thumbnails, e.g. the placeholder, are never cached, and are streamed when they're drawn.
+class thumbnail_cache final
+{
+public:
+    static constexpr int MAX_SIZE = bn::bitmap_bg::dp_direct_height();
+    /// @brief Only the adjacent thumbnails are prefetched, as the current one is drawn anyway.
+    static constexpr int SLOTS_COUNT = 2;
+    /// @brief Bytes decompressed in a prefetch step, a few of which are done in a frame within the budget.
+    /// Huffman decompression takes about 80 cycles per byte, so a step is about 20K cycles.
+    static constexpr int PREFETCH_STEP_BYTES = 256;
+
+public:
+    thumbnail_cache();
+
+    thumbnail_cache(const thumbnail_cache&) = delete;
+    thumbnail_cache& operator=(const thumbnail_cache&) = delete;
+
+public:
+    /// @brief Gets the decompressed & cropped thumbnail, if it's fully cached.
+    auto find(const thumbnail_item&) const -> bn::optional<thumbnail_item>;
+
+    /// @brief Sets the thumbnails to prefetch, in priority order.
+    /// Slots of the thumbnails not in it are reused, and the direct thumbnails in it are ignored.
+    void reserve_prefetches(bn::span<const thumbnail_item* const> items);
+
+    /// @brief Decompresses the strips of the reserved thumbnails, while the budget fits another step.
+    /// At least a step is done each call, so that it always progresses.
+    /// @param stream_buffer Buffer for `bitmap_streamer`, which shouldn't be used elsewhere until it's done.
+    /// @param budget_ticks Budget in `bn::timer` ticks.
+    /// @return `true` if every reserved thumbnail is cached.
+    bool update_prefetch(bn::span<std::uint8_t> stream_buffer, int budget_ticks);
+
+    /// @brief Cancels the thumbnail being decompressed, so that the stream buffer can be used elsewhere.
+    void cancel_prefetch();
+
+    void clear();
+
+private:
+    struct slot final
+    {
+        const thumbnail_item* item;
+        bool complete;
+        bn::size dimensions;
+        bn::span<const bn::color> palette;
+        bn::array<std::uint8_t, MAX_SIZE * MAX_SIZE> indexes;
+    };
+
+private:
+    auto find_slot(const thumbnail_item&) -> slot*;
+    auto find_slot(const thumbnail_item&) const -> const slot*;
+    auto acquire_slot() -> slot&;
+
+    void start_prefetch(slot&, const thumbnail_item&, bn::span<std::uint8_t> stream_buffer);
+
+    /// @brief Decompresses a strip of the next reserved thumbnail.
+    /// @return `true` if every reserved thumbnail is cached.
+    bool step_prefetch(bn::span<std::uint8_t> stream_buffer);
+
+private:
+    bn::array<slot, SLOTS_COUNT> _slots;
+    bn::vector<const thumbnail_item*, SLOTS_COUNT> _reserved_items;
+
+    slot* _prefetching_slot;
+    bn::optional<bitmap_streamer> _streamer;
+};
+
+} // namespace jb::sys
@@ -0,0 +1,102 @@
+#pragma once
+
+#include "sys/indexed_bitmap_item.h"
+
+#include <bn_assert.h>
+#include <bn_color.h>
+#include <bn_compression_type.h>
+#include <bn_direct_bitmap_item.h>
+#include <bn_size.h>
+#include <bn_span.h>
+
+#include <cstdint>
+
+namespace jb::sys
+{
+
+/// @brief Thumbnail of a tune, which is either a 15-bit direct color bitmap or an 8bpp palettized bitmap.
+class thumbnail_item final
+{
+public:
+    enum class format : std::uint8_t
+    {
+        DIRECT,
+        INDEXED,
+    };
+
+public:
+    constexpr explicit thumbnail_item(const bn::direct_bitmap_item& direct_item)
+        : _format(format::DIRECT), _colors_ref(direct_item.colors_ref()), _dimensions(direct_item.dimensions()),
+          _compression(direct_item.compression())
+    {
+    }
+
+    constexpr explicit thumbnail_item(const indexed_bitmap_item& indexed_item)
+        : _format(format::INDEXED), _indexes_ref(indexed_item.indexes_ref()),
+          _palette_ref(indexed_item.palette_ref()), _dimensions(indexed_item.dimensions()),
+          _compression(indexed_item.compression())
+    {
+    }
+
+public:
+    constexpr auto direct_item() const -> bn::direct_bitmap_item
+    {
+        BN_ASSERT(_format == format::DIRECT, "Not a direct thumbnail");
+
+        return bn::direct_bitmap_item(_colors_ref, _dimensions, _compression);
+    }
+
+    constexpr auto indexed_item() const -> indexed_bitmap_item
+    {
+        BN_ASSERT(_format == format::INDEXED, "Not an indexed thumbnail");
+
+        return indexed_bitmap_item(_indexes_ref, _palette_ref, _dimensions, _compression);
+    }
+
+    /// @brief Bytes of the pixels, which are either colors or palette indexes depending on the format.
+    auto pixels_ref() const -> bn::span<const std::uint8_t>
+    {
+        if (_format == format::INDEXED)
+            return _indexes_ref;
+
+        return bn::span<const std::uint8_t>(reinterpret_cast<const std::uint8_t*>(_colors_ref.data()),
+                                            _colors_ref.size() * int(sizeof(bn::color)));
+    }
+
+    constexpr int pixel_bytes() const
+    {
+        return _format == format::INDEXED ? 1 : int(sizeof(bn::color));
+    }
+
+private:
+    format _format;
+    bn::span<const bn::color> _colors_ref;
+    bn::span<const std::uint8_t> _indexes_ref;
+    bn::span<const bn::color> _palette_ref;
+    bn::size _dimensions;
+    bn::compression_type _compression;
+
+public:
+    constexpr auto format() const -> decltype((_format))
+    {
+        return _format;
+    }
+
+    /// @brief Palette of the indexed thumbnail, which is empty for the direct thumbnail.
+    constexpr auto palette_ref() const -> decltype((_palette_ref))
+    {
+        return _palette_ref;
+    }
+
+    constexpr auto dimensions() const -> decltype((_dimensions))
+    {
+        return _dimensions;
+    }
+
+    constexpr auto compression() const -> decltype((_compression))
+    {
+        return _compression;
+    }
+};
+
+} // namespace jb::sys
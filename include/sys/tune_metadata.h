@@ -0,0 +1,162 @@
+#pragma once
+
+#include <bn_array.h>
+#include <bn_assert.h>
+#include <bn_fixed.h>
+#include <bn_span.h>
+
+#include <algorithm>
+#include <cstdint>
+
+namespace jb::sys
+{
+
+/// @brief Length, loop point and channel usage of a tune, which are analyzed from its module at build time.
+///
+/// Generated by `tools/tune_analyzer.py`, so that the song data is never scanned on runtime.
+class tune_metadata final
+{
+public:
+    static constexpr int CHANNELS_COUNT = 4;
+
+    /// @brief Start of the rows which are played in a row with the same ticks, until the next order, jump
+    /// or speed change.
+    struct seek_point final
+    {
+        int ticks;
+        std::uint16_t rows_count;
+        std::uint8_t order;
+        std::uint8_t row;
+    };
+
+public:
+    /// @param total_ticks Ticks from the start to the end of the tune, or to the end of its first loop.
+    /// @param loop_start_ticks Ticks from the start to the loop point, or -1 if the tune stops by itself.
+    /// @param tick_rate Ticks per second of the module.
+    /// @param channel_notes Notes started on each channel, until the end of the tune or its first loop.
+    /// @param peak_rows_per_minute Tempo of the fastest row.
+    /// @param seek_points Visited rows where an order starts or the speed changes, sorted by their ticks,
+    /// starting from the tick 0.
+    constexpr tune_metadata(int total_ticks, int loop_start_ticks, bn::fixed tick_rate,
+                            const bn::array<int, CHANNELS_COUNT>& channel_notes, int peak_rows_per_minute,
+                            bn::span<const seek_point> seek_points)
+        : _total_ticks(total_ticks), _loop_start_ticks(loop_start_ticks), _tick_rate(tick_rate),
+          _channel_notes(channel_notes), _peak_rows_per_minute(peak_rows_per_minute), _seek_points(seek_points)
+    {
+        BN_ASSERT(total_ticks > 0, "Invalid total ticks: ", total_ticks);
+        BN_ASSERT(loop_start_ticks >= -1 && loop_start_ticks < total_ticks, "Invalid loop start ticks: ",
+                  loop_start_ticks);
+        BN_ASSERT(tick_rate > 0, "Invalid tick rate: ", tick_rate);
+        BN_ASSERT(peak_rows_per_minute > 0, "Invalid peak rows per minute: ", peak_rows_per_minute);
+        BN_ASSERT(!seek_points.empty() && seek_points[0].ticks == 0, "Invalid seek points");
+    }
+
+public:
+    constexpr bool has_loop() const
+    {
+        return _loop_start_ticks >= 0;
+    }
+
+    /// @brief Ticks of the part that repeats, or 0 if the tune stops by itself.
+    constexpr int loop_ticks() const
+    {
+        return has_loop() ? _total_ticks - _loop_start_ticks : 0;
+    }
+
+    /// @brief Position in the tune after the `elapsed_ticks`, which wraps around to the loop point,
+    /// or stays at the end if the tune stops by itself.
+    constexpr int position_ticks(int elapsed_ticks) const
+    {
+        if (elapsed_ticks < _total_ticks)
+            return elapsed_ticks;
+
+        if (!has_loop())
+            return _total_ticks;
+
+        return _loop_start_ticks + (elapsed_ticks - _loop_start_ticks) % loop_ticks();
+    }
+
+    constexpr int channel_notes(int channel) const
+    {
+        BN_ASSERT(channel >= 0 && channel < CHANNELS_COUNT, "Invalid channel: ", channel);
+
+        return _channel_notes[channel];
+    }
+
+    constexpr bool channel_used(int channel) const
+    {
+        return channel_notes(channel) > 0;
+    }
+
+    /// @brief Row to seek to, so that it's played at the `ticks` from the start of the tune.
+    ///
+    /// Rows take the same ticks within a seek point, so the row is found by dividing its ticks,
+    /// which is only off by the rounding of the fractional ticks.
+    /// @return Seek point of the row, with its ticks snapped to the start of the row and `rows_count` of 1.
+    constexpr auto seek_target(int ticks) const -> seek_point
+    {
+        BN_ASSERT(ticks >= 0 && ticks < _total_ticks, "Invalid seek ticks: ", ticks);
+
+        // Last seek point which starts at or before the ticks.
+        int lo = 0;
+        int hi = _seek_points.size();
+        while (hi - lo > 1)
+        {
+            const int mid = (lo + hi) / 2;
+            if (_seek_points[mid].ticks <= ticks)
+                lo = mid;
+            else
+                hi = mid;
+        }
+
+        const seek_point& point = _seek_points[lo];
+        const int end_ticks = lo + 1 < _seek_points.size() ? _seek_points[lo + 1].ticks : _total_ticks;
+        const int point_ticks = end_ticks - point.ticks;
+
+        const int rows = point.rows_count;
+        const int row_offset = std::min((ticks - point.ticks) * rows / point_ticks, rows - 1);
+
+        return seek_point{
+            point.ticks + row_offset * point_ticks / rows,
+            1,
+            point.order,
+            std::uint8_t(point.row + row_offset),
+        };
+    }
+
+private:
+    int _total_ticks;
+    int _loop_start_ticks;
+    bn::fixed _tick_rate;
+    bn::array<int, CHANNELS_COUNT> _channel_notes;
+    int _peak_rows_per_minute;
+    bn::span<const seek_point> _seek_points;
+
+public:
+    constexpr auto total_ticks() const -> decltype((_total_ticks))
+    {
+        return _total_ticks;
+    }
+
+    constexpr auto loop_start_ticks() const -> decltype((_loop_start_ticks))
+    {
+        return _loop_start_ticks;
+    }
+
+    constexpr auto tick_rate() const -> decltype((_tick_rate))
+    {
+        return _tick_rate;
+    }
+
+    constexpr auto peak_rows_per_minute() const -> decltype((_peak_rows_per_minute))
+    {
+        return _peak_rows_per_minute;
+    }
+
+    constexpr auto seek_points() const -> decltype((_seek_points))
+    {
+        return _seek_points;
+    }
+};
+
+} // namespace jb::sys
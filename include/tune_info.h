@@ -8,9 +8,14 @@
 namespace bn
 {
 class dmg_music_item;
-class direct_bitmap_item;
 } // namespace bn
 
+namespace jb::sys
+{
+class thumbnail_item;
+class tune_metadata;
+} // namespace jb::sys
+
 namespace jb
 {
 
@@ -30,11 +35,12 @@ public:
 
 public:
     constexpr tune_info(const bn::dmg_music_item& tune, category category_, bool loop,
-                        const bn::direct_bitmap_item* thumbnail, const bn::string_view& tune_name,
-                        const bn::string_view& composer_name, const bn::string_view& remixer_name,
-                        const bn::string_view& description)
-        : _tune(tune), _category(category_), _loop(loop), _thumbnail(thumbnail), _tune_name(tune_name),
-          _composer_name(composer_name), _remixer_name(remixer_name), _description(description)
+                        const sys::thumbnail_item* thumbnail, const sys::tune_metadata& metadata,
+                        const bn::string_view& tune_name, const bn::string_view& composer_name,
+                        const bn::string_view& remixer_name, const bn::string_view& description)
+        : _tune(tune), _category(category_), _loop(loop), _thumbnail(thumbnail), _metadata(metadata),
+          _tune_name(tune_name), _composer_name(composer_name), _remixer_name(remixer_name),
+          _description(description)
     {
     }
 
@@ -42,7 +48,8 @@ private:
     const bn::dmg_music_item& _tune;
     category _category;
     bool _loop;
-    const bn::direct_bitmap_item* _thumbnail;
+    const sys::thumbnail_item* _thumbnail;
+    const sys::tune_metadata& _metadata;
     bn::string_view _tune_name;
     bn::string_view _composer_name;
     bn::string_view _remixer_name;
@@ -69,6 +76,12 @@ public:
         return _thumbnail;
     }
 
+    /// @brief Length, loop point and channel usage, analyzed at build time.
+    constexpr auto metadata() const -> decltype(_metadata)
+    {
+        return _metadata;
+    }
+
     constexpr auto tune_name() const -> decltype((_tune_name))
     {
         return _tune_name;
@@ -1,9 +1,11 @@
 #pragma once
 
 #include "sys/text_generators.h"
+#include "sys/text_sprite_cache.h"
 
 #include "ibn_function.h"
 
+#include <bn_array.h>
 #include <bn_fixed_point.h>
 #include <bn_optional.h>
 #include <bn_sound_handle.h>
@@ -33,9 +35,12 @@ class menu_navigator_builder;
 /// @brief Helper to navigate the menu.
 ///
 /// * Renders the menu option texts.
+///   * If lines per frame is set, a page is rendered over multiple frames, starting from the pointed line.
 /// * Navigate the menu options with Up/Down key.
 ///   * If the number of menu options exceeds the max lines,
 ///     it also allows navigating between pages with Left/Right key.
+///   * In `list_mode::SCROLL`, the list smoothly scrolls instead of flipping pages,
+///     and only the row entering the viewport is rendered.
 /// * Activate the pointed menu option with A key.
 /// * Cancel the navigating with B key.
 class menu_navigator final
@@ -43,6 +48,19 @@ class menu_navigator final
 public:
     static constexpr int MAX_MENUS_COUNT = 9;
 
+    /// @brief Max number of rows kept rendered in `list_mode::SCROLL`.
+    /// Visible rows plus one row above and one row below.
+    static constexpr int MAX_SCROLL_ROWS_COUNT = MAX_MENUS_COUNT + 2;
+    static constexpr int MAX_SPRITES_PER_SCROLL_ROW = 8;
+
+    enum class list_mode : std::uint8_t
+    {
+        /// @brief Discrete pages, which are torn down and rebuilt on page change.
+        PAGE,
+        /// @brief Virtualized list, which keeps a ring of rows and smoothly scrolls them.
+        SCROLL,
+    };
+
 public:
     /// @brief Callback that fires when pointed index has been changed.
     /// @param prev_page Previous page.
@@ -79,6 +97,11 @@ public:
 public:
     void update();
 
+    /// @brief Checks if there's nothing to do in `update()`, until there's an input.
+    ///
+    /// Nothing to render, not scrolling the list, and no direction is held.
+    bool idle() const;
+
     void reserve_refresh_page();
     void clear_page();
 
@@ -102,11 +125,52 @@ private:
 
     auto get_held_directions() -> directions;
 
+private:
+    struct line_sprites final
+    {
+        std::uint8_t start_idx;
+        std::uint8_t end_idx;
+        bool rendered;
+    };
+
 private:
     void commit_refresh_page();
+    void render_pending_lines();
+    bool render_line(unsigned page, unsigned line);
+    bool render_text(const bn::fixed_point& top_left_position, const bn::string_view& text,
+                     bn::ivector<bn::sprite_ptr>& output_sprites);
 
     void refresh_palette();
 
+    void refresh_for_pointed_changed(unsigned prev_pointed_index);
+
+private:
+    struct scroll_row final
+    {
+        int menu_index = -1;
+        bn::fixed y;
+        bn::vector<bn::sprite_ptr, MAX_SPRITES_PER_SCROLL_ROW> sprites;
+    };
+
+    void commit_refresh_scroll_list();
+    void update_scroll_list();
+    void render_scroll_rows();
+    bool render_scroll_row(unsigned index);
+    void reposition_scroll_rows();
+    void recolor_scroll_row(unsigned index);
+    void clear_scroll_rows();
+
+    void fit_list_top_index();
+
+    auto get_scroll_row(unsigned index) -> scroll_row&;
+    /// @brief Range of the rows kept rendered: visible rows plus one row above and one row below.
+    int get_scroll_rows_begin_index() const;
+    int get_scroll_rows_end_index() const;
+
+    unsigned get_scroll_rows_count() const;
+    auto get_scroll_row_y(unsigned index) const -> bn::fixed;
+    bool is_scroll_row_visible(bn::fixed row_y) const;
+
 private:
     unsigned get_page(unsigned index) const;
     unsigned get_max_lines_for_page(unsigned page) const;
@@ -117,6 +181,7 @@ private:
     auto get_line_x() const -> bn::fixed;
     auto get_line_y(unsigned line) const -> bn::fixed;
     auto get_line_pos(unsigned line) const -> bn::fixed_point;
+    int get_line_height() const;
 
     auto get_menu_x() const -> bn::fixed;
     auto get_menu_y(unsigned index) const -> bn::fixed;
@@ -133,7 +198,8 @@ private:
     ibn::sprite_text_generator& _text_gen;
     const bn::span<const bn::string_view> _menu_strings;
     const bn::span<const bn::string_view> _menu_strings_2;
-    bn::ivector<bn::sprite_ptr>& _output_sprites;
+    /// Null in `list_mode::SCROLL`, which keeps the sprites in `_scroll_rows` instead.
+    bn::ivector<bn::sprite_ptr>* const _output_sprites;
 
     const int _init_output_sprites_size;
 
@@ -147,6 +213,7 @@ private:
     const bn::sound_item* const _activated_sfx;
     const bn::sound_item* const _activate_failed_sfx;
     const bn::sound_item* const _cancelled_sfx;
+    sys::text_sprite_cache* const _text_sprite_cache;
 
     const bn::fixed_point _top_left_position;
     const unsigned _total_pages;
@@ -155,6 +222,9 @@ private:
     const std::uint8_t _max_lines;
     const std::uint8_t _scroll_start_delay;
     const std::uint8_t _scroll_continue_delay;
+    const std::uint8_t _lines_per_frame;
+    const list_mode _list_mode;
+    const std::uint8_t _list_scroll_speed;
 
     bool _refresh_page_reserved;
 
@@ -168,7 +238,17 @@ private:
 
     bn::optional<bn::sound_handle> _sfx_handle;
 
-    bn::vector<std::uint8_t, MAX_MENUS_COUNT + 1> _menu_spr_start_idxes;
+    bn::vector<line_sprites, MAX_MENUS_COUNT> _lines_sprites;
+
+    /// Lines of the current page that are not rendered yet, in reverse render order.
+    bn::vector<std::uint8_t, MAX_MENUS_COUNT> _pending_lines;
+
+    /// Top index of the viewport in `list_mode::SCROLL`, which the list is scrolling to.
+    unsigned _list_top_index;
+    /// Current scroll amount in pixels in `list_mode::SCROLL`.
+    int _list_scroll_y;
+
+    bn::array<scroll_row, MAX_SCROLL_ROWS_COUNT> _scroll_rows;
 };
 
 } // namespace jb::ui
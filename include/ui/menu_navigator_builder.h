@@ -20,13 +20,17 @@ public:
     menu_navigator_builder(sys::text_generators::font font, bn::span<const bn::string_view> menu_strings,
                            bn::ivector<bn::sprite_ptr>& output_sprites);
 
+    /// @brief Constructor without the output sprites, which is only for `list_mode::SCROLL`,
+    /// as it keeps the sprites in its own rows.
+    menu_navigator_builder(sys::text_generators::font font, bn::span<const bn::string_view> menu_strings);
+
 public:
     auto build(sys::text_generators&) -> menu_navigator;
 
 public:
     auto font() const -> sys::text_generators::font;
     auto menu_strings() const -> bn::span<const bn::string_view>;
-    auto output_sprites() const -> bn::ivector<bn::sprite_ptr>&;
+    auto output_sprites() const -> bn::ivector<bn::sprite_ptr>*;
 
     auto menu_strings_2() const -> bn::span<const bn::string_view>;
     auto set_menu_strings_2(const bn::span<const bn::string_view>& strs) -> menu_navigator_builder&;
@@ -54,6 +58,27 @@ public:
     unsigned scroll_continue_delay() const;
     auto set_scroll_continue_delay(unsigned delay) -> menu_navigator_builder&;
 
+    /// @brief Gets the max number of lines rendered in a frame.
+    /// `0` means the whole page is rendered in a frame.
+    unsigned lines_per_frame() const;
+    /// @brief Sets the max number of lines rendered in a frame.
+    /// `0` means the whole page is rendered in a frame.
+    auto set_lines_per_frame(unsigned lines) -> menu_navigator_builder&;
+
+    auto list_mode() const -> menu_navigator::list_mode;
+    auto set_list_mode(menu_navigator::list_mode mode) -> menu_navigator_builder&;
+
+    /// @brief Gets the scroll speed in pixels per frame, used in `list_mode::SCROLL`.
+    unsigned list_scroll_speed() const;
+    /// @brief Sets the scroll speed in pixels per frame, used in `list_mode::SCROLL`.
+    auto set_list_scroll_speed(unsigned speed) -> menu_navigator_builder&;
+
+    /// @brief Gets the cache to reuse the rendered line texts from.
+    auto text_sprite_cache() const -> sys::text_sprite_cache*;
+    /// @brief Sets the cache to reuse the rendered line texts from.
+    /// `nullptr` means every line is rendered from scratch.
+    auto set_text_sprite_cache(sys::text_sprite_cache* cache) -> menu_navigator_builder&;
+
     bool input_enabled() const;
     auto set_input_enabled(bool enabled) -> menu_navigator_builder&;
 
@@ -90,7 +115,7 @@ public:
 private:
     const sys::text_generators::font _font;
     const bn::span<const bn::string_view> _menu_strings;
-    bn::ivector<bn::sprite_ptr>& _output_sprites;
+    bn::ivector<bn::sprite_ptr>* _output_sprites;
     bn::span<const bn::string_view> _menu_strings_2;
 
     bn::sprite_palette_item _pointed_palette;
@@ -103,6 +128,7 @@ private:
     const bn::sound_item* _activated_sfx;
     const bn::sound_item* _activate_failed_sfx;
     const bn::sound_item* _cancelled_sfx;
+    sys::text_sprite_cache* _text_sprite_cache;
 
     bn::fixed_point _top_left_position;
     std::uint8_t _bg_priority;
@@ -110,6 +136,9 @@ private:
     std::uint8_t _max_lines;
     std::uint8_t _scroll_start_delay;
     std::uint8_t _scroll_continue_delay;
+    std::uint8_t _lines_per_frame;
+    menu_navigator::list_mode _list_mode;
+    std::uint8_t _list_scroll_speed;
 
     bool _input_enabled;
 
@@ -0,0 +1,80 @@
+#pragma once
+
+#include "sys/text_generators.h"
+
+#include <bn_array.h>
+#include <bn_fixed_point.h>
+#include <bn_sprite_ptr.h>
+#include <bn_sprite_tiles_ptr.h>
+#include <bn_vector.h>
+
+namespace jb::sys
+{
+class tune_metadata;
+}
+
+namespace jb::ui
+{
+
+/// @brief Elapsed and total time of the playing tune, and a progress bar across the screen.
+///
+/// * Time is made of a sprite per character, and the digit sprites of the elapsed time swap their tiles
+///   to the pre-rendered digit glyphs when they change, so that no text is generated while playing.
+/// * Progress bar is a row of sprites which slides in from the left edge of the screen,
+///   so that it's only moved as the tune plays.
+class playback_progress final
+{
+public:
+    static constexpr auto FONT = sys::text_generators::font::GALMURI_7;
+
+    /// @brief Up to "99:59/99:59"
+    static constexpr int MAX_TIME_CHARS = 11;
+    static constexpr int MAX_MINUTES_DIGITS = 2;
+
+    static constexpr int BAR_SPRITES_COUNT = 8;
+
+public:
+    playback_progress(sys::text_generators&);
+
+    playback_progress(const playback_progress&) = delete;
+    playback_progress& operator=(const playback_progress&) = delete;
+
+public:
+    /// @brief Shows the progress of the tune, with the time right aligned to the `top_right_position`.
+    void show(const sys::tune_metadata&, int elapsed_ticks, const bn::fixed_point& top_right_position,
+              int bar_top);
+
+    /// @brief Releases every sprite and tiles, including the pre-rendered digit glyphs.
+    void hide();
+
+    bool shown() const;
+
+    /// @brief Left edge of the time text, so that the other texts can avoid it.
+    int time_left() const;
+
+    /// @brief Moves the progress bar and swaps the changed digits.
+    /// This should be called each frame, as it doesn't generate any text.
+    void update(int elapsed_ticks);
+
+private:
+    void render_digit_glyphs();
+    void update_sprites(int elapsed_ticks);
+
+private:
+    sys::text_generators& _text_gens;
+    const sys::tune_metadata* _metadata = nullptr;
+
+    bn::vector<bn::sprite_tiles_ptr, 10> _digit_tiles;
+    bn::vector<bn::sprite_ptr, MAX_TIME_CHARS> _time_sprites;
+    bn::vector<bn::sprite_ptr, BAR_SPRITES_COUNT> _bar_sprites;
+
+    int _time_left = 0;
+    int _minutes_digits = 1;
+    int _bar_top = 0;
+
+    int _shown_seconds = -1;
+    int _shown_bar_width = -1;
+    bn::array<int, MAX_MINUTES_DIGITS + 2> _shown_digits;
+};
+
+} // namespace jb::ui
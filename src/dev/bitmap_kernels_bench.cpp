@@ -0,0 +1,131 @@
+#include "dev/bitmap_kernels_bench.h"
+
+#include "sys/bitmap_kernels.h"
+
+#include <bn_array.h>
+#include <bn_bitmap_bg.h>
+#include <bn_colors.h>
+#include <bn_direct_bitmap_item.h>
+#include <bn_direct_bitmap_roi.h>
+#include <bn_dp_direct_bitmap_bg_painter.h>
+#include <bn_log.h>
+#include <bn_memory.h>
+#include <bn_timer.h>
+
+#include <cstdint>
+
+namespace jb::dev
+{
+
+namespace
+{
+
+constexpr int SIZE = bn::bitmap_bg::dp_direct_height();
+constexpr int PAGE_STRIDE = bn::bitmap_bg::dp_direct_width();
+constexpr int SRC_ROWS = 16;
+
+/// Full rows of the thumbnail, which are a multiple of the 8 words block of `CpuFastSet`.
+constexpr int ROW_WORDS = SIZE / 2;
+static_assert(ROW_WORDS % 8 == 0);
+
+constexpr std::uint32_t CPU_FAST_SET_FILL = 1u << 24;
+
+alignas(int) BN_DATA_EWRAM bn::array<bn::color, SIZE * SRC_ROWS> src_colors;
+
+bool benched = false;
+
+/// @param words Multiple of 8, as the BIOS rounds it up.
+void cpu_fast_set(const void* src, void* dst, int words, bool fill)
+{
+    register const void* r0 asm("r0") = src;
+    register void* r1 asm("r1") = dst;
+    register std::uint32_t r2 asm("r2") = std::uint32_t(words) | (fill ? CPU_FAST_SET_FILL : 0);
+
+#if defined(__thumb__)
+    asm volatile("swi 0x0C" : "+r"(r0), "+r"(r1), "+r"(r2) : : "r3", "memory");
+#else
+    asm volatile("swi 0x0C0000" : "+r"(r0), "+r"(r1), "+r"(r2) : : "r3", "memory");
+#endif
+}
+
+} // namespace
+
+void bench_bitmap_kernels(bn::dp_direct_bitmap_bg_painter& painter)
+{
+    if (benched)
+        return;
+
+    benched = true;
+
+    const bn::direct_bitmap_item src_item(src_colors, bn::size(SIZE, SRC_ROWS));
+    const bn::direct_bitmap_roi src_roi(src_item, 0, 0, SIZE, SRC_ROWS);
+    std::uint16_t* page = sys::bitmap_kernels::dp_back_page(painter);
+    const std::uint32_t fill_pair = bn::colors::black.data() | (std::uint32_t(bn::colors::black.data()) << 16);
+    const bool dma_enabled = bn::memory::dma_enabled();
+
+    bn::timer timer;
+
+    // Fill full rows, so that every variant fills the same rectangle.
+    painter.unsafe_rectangle(0, 2, SIZE - 1, SIZE - 3, bn::colors::black);
+    const int painter_fill_ticks = timer.elapsed_ticks_with_restart();
+
+    // Kernels use `bn::memory`, so they're benched with DMA disabled and enabled.
+    bn::memory::set_dma_enabled(false);
+    timer.restart();
+    sys::bitmap_kernels::fill_rect(page, 0, 2, SIZE, SIZE - 4, bn::colors::black);
+    const int kernel_fill_ticks = timer.elapsed_ticks_with_restart();
+
+    bn::memory::set_dma_enabled(true);
+    timer.restart();
+    sys::bitmap_kernels::fill_rect(page, 0, 2, SIZE, SIZE - 4, bn::colors::black);
+    const int dma_fill_ticks = timer.elapsed_ticks_with_restart();
+
+    for (int y = 2; y < SIZE - 2; ++y)
+        cpu_fast_set(&fill_pair, page + y * PAGE_STRIDE, ROW_WORDS, true);
+    const int cpu_fast_set_fill_ticks = timer.elapsed_ticks_with_restart();
+
+    // Blit
+    for (int y = 0; y < SIZE; y += SRC_ROWS)
+        painter.unsafe_blit(0, y, src_roi);
+    const int painter_blit_ticks = timer.elapsed_ticks_with_restart();
+
+    bn::memory::set_dma_enabled(false);
+    timer.restart();
+    for (int y = 0; y < SIZE; y += SRC_ROWS)
+        sys::bitmap_kernels::blit_rect(page, 0, y, src_colors.data(), SIZE, SIZE, SRC_ROWS);
+    const int kernel_blit_ticks = timer.elapsed_ticks_with_restart();
+
+    bn::memory::set_dma_enabled(true);
+    timer.restart();
+    for (int y = 0; y < SIZE; y += SRC_ROWS)
+        sys::bitmap_kernels::blit_rect(page, 0, y, src_colors.data(), SIZE, SIZE, SRC_ROWS);
+    const int dma_blit_ticks = timer.elapsed_ticks_with_restart();
+
+    bn::memory::set_dma_enabled(dma_enabled);
+
+    for (int y = 0; y < SIZE; ++y)
+        cpu_fast_set(src_colors.data() + (y % SRC_ROWS) * SIZE, page + y * PAGE_STRIDE, ROW_WORDS, false);
+    const int cpu_fast_set_blit_ticks = timer.elapsed_ticks_with_restart();
+
+    // Borders
+    painter.unsafe_horizontal_line(1, SIZE - 2, 1, bn::colors::black);
+    painter.unsafe_vertical_line(1, 1, SIZE - 2, bn::colors::black);
+    painter.unsafe_vertical_line(SIZE - 2, 1, SIZE - 2, bn::colors::black);
+    painter.unsafe_horizontal_line(1, SIZE - 2, SIZE - 2, bn::colors::black);
+    painter.unsafe_horizontal_line(0, SIZE - 1, 0, bn::colors::gray);
+    painter.unsafe_vertical_line(0, 0, SIZE - 1, bn::colors::gray);
+    painter.unsafe_vertical_line(SIZE - 1, 0, SIZE - 1, bn::colors::gray);
+    painter.unsafe_horizontal_line(0, SIZE - 1, SIZE - 1, bn::colors::gray);
+    const int painter_borders_ticks = timer.elapsed_ticks_with_restart();
+
+    sys::bitmap_kernels::draw_frame(page, 0, 0, SIZE, SIZE, bn::colors::gray, bn::colors::black);
+    const int kernel_borders_ticks = timer.elapsed_ticks_with_restart();
+
+    BN_LOG("[dev] Fill ticks - painter: ", painter_fill_ticks, ", kernel: ", kernel_fill_ticks,
+           ", kernel with DMA: ", dma_fill_ticks, ", CpuFastSet: ", cpu_fast_set_fill_ticks);
+    BN_LOG("[dev] Blit ticks - painter: ", painter_blit_ticks, ", kernel: ", kernel_blit_ticks,
+           ", kernel with DMA: ", dma_blit_ticks, ", CpuFastSet: ", cpu_fast_set_blit_ticks);
+    BN_LOG("[dev] Borders ticks - painter: ", painter_borders_ticks, ", kernel: ", kernel_borders_ticks);
+}
+
+} // namespace jb::dev
@@ -0,0 +1,64 @@
+#include "dev/dev_counters.h"
+
+#include <bn_array.h>
+#include <bn_assert.h>
+#include <bn_log.h>
+#include <bn_string_view.h>
+
+#include <algorithm>
+
+namespace jb::dev
+{
+
+namespace
+{
+
+constexpr bn::array<bn::string_view, (int)counter::MAX_COUNT> COUNTER_NAMES = {
+    "SRAM writes",
+    "SRAM skipped writes",
+    "SRAM skipped bytes",
+    "Text cache hits",
+    "Text cache misses",
+    "Scene pool max used bytes",
+    "Sprite tiles free",
+    "Sprite tiles free blocks",
+    "Sprite tiles largest free block",
+    "Progress update max ticks",
+};
+
+static_assert(std::ranges::none_of(COUNTER_NAMES, [](const bn::string_view& name) { return name.empty(); }),
+              "Missing name in COUNTER_NAMES");
+
+bn::array<int, (int)counter::MAX_COUNT> counter_values;
+
+} // namespace
+
+void add_counter(counter kind, int amount)
+{
+    BN_ASSERT(kind < counter::MAX_COUNT, "Invalid counter kind: ", (int)kind);
+
+    counter_values[(int)kind] += amount;
+}
+
+void set_counter(counter kind, int value)
+{
+    BN_ASSERT(kind < counter::MAX_COUNT, "Invalid counter kind: ", (int)kind);
+
+    counter_values[(int)kind] = value;
+}
+
+auto counter_value(counter kind) -> int
+{
+    BN_ASSERT(kind < counter::MAX_COUNT, "Invalid counter kind: ", (int)kind);
+
+    return counter_values[(int)kind];
+}
+
+void log_counter(counter kind)
+{
+    BN_ASSERT(kind < counter::MAX_COUNT, "Invalid counter kind: ", (int)kind);
+
+    BN_LOG("[dev] ", COUNTER_NAMES[(int)kind], ": ", counter_values[(int)kind]);
+}
+
+} // namespace jb::dev
@@ -0,0 +1,80 @@
+#include "dev/sprite_tiles_probe.h"
+
+#include "dev/dev_counters.h"
+
+#include <bn_optional.h>
+#include <bn_sprite_tiles.h>
+#include <bn_sprite_tiles_ptr.h>
+#include <bn_vector.h>
+
+#include <utility>
+
+namespace jb::dev
+{
+
+namespace
+{
+
+/// Allocations are capped, as each one takes a tiles item of butano.
+constexpr int MAX_PROBED_BLOCKS = 32;
+
+/// Binary searches the largest 4bpp tiles count that can be allocated at once, and allocates it.
+auto allocate_largest_free_block() -> bn::optional<bn::sprite_tiles_ptr>
+{
+    int low = 1;
+    int high = bn::sprite_tiles::available_tiles_count();
+    int largest = 0;
+
+    while (low <= high)
+    {
+        const int mid = (low + high) / 2;
+
+        // Released right away, so it doesn't take the room of the larger probes.
+        if (bn::sprite_tiles_ptr::allocate_optional(mid, bn::bpp_mode::BPP_4).has_value())
+        {
+            largest = mid;
+            low = mid + 1;
+        }
+        else
+        {
+            high = mid - 1;
+        }
+    }
+
+    if (largest == 0)
+        return bn::nullopt;
+
+    return bn::sprite_tiles_ptr::allocate(largest, bn::bpp_mode::BPP_4);
+}
+
+} // namespace
+
+void log_sprite_tiles_fragmentation()
+{
+    set_counter(counter::SPRITE_TILES_FREE, bn::sprite_tiles::available_tiles_count());
+
+    // Largest block is allocated first, and each allocation takes the whole of the largest block left.
+    bn::vector<bn::sprite_tiles_ptr, MAX_PROBED_BLOCKS> blocks;
+    int largest_block_tiles = 0;
+
+    while (!blocks.full())
+    {
+        bn::optional<bn::sprite_tiles_ptr> block = allocate_largest_free_block();
+        if (!block.has_value())
+            break;
+
+        if (blocks.empty())
+            largest_block_tiles = block->tiles_count();
+
+        blocks.push_back(std::move(*block));
+    }
+
+    set_counter(counter::SPRITE_TILES_FREE_BLOCKS, blocks.size());
+    set_counter(counter::SPRITE_TILES_LARGEST_FREE_BLOCK, largest_block_tiles);
+
+    log_counter(counter::SPRITE_TILES_FREE);
+    log_counter(counter::SPRITE_TILES_FREE_BLOCKS);
+    log_counter(counter::SPRITE_TILES_LARGEST_FREE_BLOCK);
+}
+
+} // namespace jb::dev
@@ -21,7 +21,9 @@ int main()
     while (true)
     {
         scene_stack.update();
+        scene_context.playback().update();
         scene_context.transitions().update();
+        scene_context.config_save().update();
 
         bn::core::update();
         IBN_STATS_UPDATE;
@@ -1,11 +1,16 @@
 #include "scn/jukebox.h"
 
+#include "dev/bitmap_kernels_bench.h"
 #include "scn/licenses_list.h"
 #include "scn/scene_context.h"
 #include "scn/scene_stack.h"
+#include "sys/bitmap_kernels.h"
+#include "sys/bitmap_streamer.h"
+#include "sys/tune_metadata.h"
 #include "tune_info.h"
 #include "ui/menu_navigator_builder.h"
 
+#include <bn_bitmap_bg.h>
 #include <bn_colors.h>
 #include <bn_display.h>
 #include <bn_dmg_music.h>
@@ -15,6 +20,8 @@
 #include <bn_keypad.h>
 #include <bn_sstream.h>
 #include <bn_string.h>
+#include <bn_timer.h>
+#include <bn_timers.h>
 
 #include <algorithm>
 
@@ -27,6 +34,18 @@ namespace
 {
 
 constexpr bn::color LIGHT_GRAY(0x5294);
+constexpr bn::color THUMBNAIL_PLACEHOLDER_COLOR(0x0842);
+
+/// Frames the cursor should stay on a tune before its thumbnail is loaded,
+/// so that scrolling through the list doesn't decompress every thumbnail on the way.
+constexpr int THUMBNAIL_DWELL_FRAMES = 12;
+
+/// Thumbnail redraw and prefetch can use up to `1 / THUMBNAIL_FRAME_BUDGET_DIVISOR` of a frame.
+constexpr int THUMBNAIL_FRAME_BUDGET_DIVISOR = 8;
+constexpr int THUMBNAIL_CLEAR_STEP_ROWS = 16;
+/// Huffman decompression takes about 80 cycles per byte, so a step is about 20K cycles with the blit,
+/// which fits in the budget (35K cycles) on its own.
+constexpr int THUMBNAIL_BLIT_STEP_BYTES = 256;
 
 constexpr bn::fixed_point BG_POS(3, 29);
 constexpr int BG_SIZE = bn::bitmap_bg::dp_direct_height();
@@ -36,6 +55,58 @@ constexpr bn::fixed RIGHT_BTN_X = 197;
 constexpr bn::fixed TOP_BTN_Y = 133;
 constexpr bn::fixed BOTTOM_BTN_Y = 150;
 
+constexpr int SEEK_STEP_SECONDS = 5;
+
+constexpr bn::fixed_point TIME_TOP_RIGHT_POS(bn::display::width() - 2, 3);
+constexpr int PROGRESS_BAR_TOP = 26;
+
+constexpr sys::thumbnail_item NO_THUMBNAIL(bn::direct_bitmap_items::no_thumbnail);
+
+auto get_thumbnail(unsigned tune_index) -> const sys::thumbnail_item&
+{
+    const tune_info& info = tune_info::tunes_list()[tune_index];
+
+    return info.thumbnail() ? *info.thumbnail() : NO_THUMBNAIL;
+}
+
+/// Blits the rows of the uncompressed thumbnail, looking up the palette if it's indexed.
+void blit_thumbnail_rows(std::uint16_t* page, const sys::thumbnail_item& thumbnail, int src_x, int src_y, int x, int y,
+                         int width, int height)
+{
+    const int src_stride = thumbnail.dimensions().width();
+    const std::uint8_t* src = thumbnail.pixels_ref().data() + (src_y * src_stride + src_x) * thumbnail.pixel_bytes();
+
+    if (thumbnail.format() == sys::thumbnail_item::format::INDEXED)
+    {
+        sys::bitmap_kernels::blit_indexed_rect(page, x, y, src, src_stride, thumbnail.palette_ref().data(), width,
+                                               height);
+    }
+    else
+    {
+        sys::bitmap_kernels::blit_rect(page, x, y, reinterpret_cast<const bn::color*>(src), src_stride, width, height);
+    }
+}
+
+/// Longest prefix of the text that fits in the width with a trailing "…", or the text itself if it fits.
+auto fit_text(const ibn::sprite_text_generator& text_gen, const bn::string_view& text, int max_width)
+    -> bn::string_view
+{
+    if (text_gen.width(text) <= max_width)
+        return text;
+
+    const int ellipsis_width = text_gen.width("…");
+    int size = text.size();
+    do
+    {
+        // Step back to the previous UTF-8 character boundary.
+        do
+            --size;
+        while (size > 0 && (text[size] & 0xC0) == 0x80);
+    } while (size > 0 && text_gen.width(text.substr(0, size)) + ellipsis_width > max_width);
+
+    return text.substr(0, size);
+}
+
 auto create_bg_painter() -> bn::dp_direct_bitmap_bg_painter
 {
     return bn::dp_direct_bitmap_bg_painter(
@@ -44,8 +115,13 @@ auto create_bg_painter() -> bn::dp_direct_bitmap_bg_painter
 
 } // namespace
 
-jukebox::jukebox(scene_context& ctx) : scene(ctx), _tunes_navigator(init_tunes_navigator())
+jukebox::jukebox(scene_context& ctx)
+    : scene(ctx, _fixed_texts_arena),
+      _playback_observer([this](sys::playback_event event) { on_playback_event(event); }),
+      _progress(ctx.text_generators()), _tunes_navigator(init_tunes_navigator())
 {
+    ctx.playback().subscribe(_playback_observer);
+
     bn::dmg_music::set_master_volume(bn::dmg_music_master_volume::FULL);
     play_at_cursor();
 
@@ -54,26 +130,49 @@ jukebox::jukebox(scene_context& ctx) : scene(ctx), _tunes_navigator(init_tunes_n
 
 jukebox::~jukebox()
 {
-    bn::dmg_music::stop();
+    context().config_save().flush();
+
+    context().playback().stop();
 }
 
 bool jukebox::update()
 {
-    if (_playing_index.has_value() && !bn::dmg_music::playing())
-    {
-        _playing_index.reset();
-        redraw_tune_head_texts();
-        redraw_a_texts();
-    }
+    update_thumbnail_bg();
+    _progress.update(context().playback().elapsed_ticks());
 
     switch (_state)
     {
     case state::TUNE_LIST:
+        // START + Left/Right seeks the playing tune, instead of moving the cursor.
+        _tunes_navigator.set_input_enabled(!bn::keypad::start_held());
         _tunes_navigator.update();
+        update_thumbnail_prefetch();
+
+        if (bn::keypad::start_held())
+        {
+            if (bn::keypad::left_pressed())
+                seek_by(-SEEK_STEP_SECONDS);
+            else if (bn::keypad::right_pressed())
+                seek_by(SEEK_STEP_SECONDS);
+        }
 
         if (bn::keypad::select_pressed())
             context().stack().reserve_push_with_delay<licenses_list>(0, context());
 
+        if (bn::keypad::l_pressed())
+        {
+            auto& playlist = context().playlist();
+            playlist.set_repeat(static_cast<sys::repeat_mode>(((int)playlist.repeat() + 1) %
+                                                              (int)sys::repeat_mode::MAX_COUNT));
+            redraw_playlist_texts();
+        }
+        if (bn::keypad::r_pressed())
+        {
+            auto& playlist = context().playlist();
+            playlist.set_shuffle(!playlist.shuffle());
+            redraw_playlist_texts();
+        }
+
         break;
 
     case state::TUNE_INFO:
@@ -89,62 +188,92 @@ bool jukebox::update()
 
 void jukebox::cover(bn::type_id_t)
 {
+    _covered = true;
+
+    context().config_save().flush();
+
     _bg_painter.reset();
+    _thumbnail_dwell_frames_left = 0;
+    _thumbnail_placeholder_shown = false;
+    _thumbnail_stage = thumbnail_stage::NONE;
+    _thumbnail_cached_item.reset();
+    _thumbnail_streamer.reset();
 
     _tune_head_text_sprites.clear();
     _a_text_sprites.clear();
-    _b_text_sprites.clear();
-    _start_text_sprites.clear();
-    _select_text_sprites.clear();
-    _list_text_sprites.clear();
+    arena().release();
+    _playlist_text_sprites.clear();
+    _tunes_navigator.clear_page();
+    _progress.hide();
+
+    // Give the sprite VRAM back to the covering scene.
+    context().text_sprite_cache().clear();
 }
 
 void jukebox::uncover()
 {
+    _covered = false;
+
     if (!_bg_painter.has_value())
         _bg_painter = create_bg_painter();
 
+    if constexpr (JB_DEVBUILD)
+        dev::bench_bitmap_kernels(*_bg_painter);
+
     redraw_thumbnail_bg();
+    reserve_thumbnail_prefetches();
 
     redraw_tune_head_texts();
     redraw_a_texts();
-    redraw_b_texts();
-    redraw_start_texts();
-    redraw_select_texts();
+    redraw_fixed_texts();
+    redraw_playlist_texts();
 
     redraw_tune_list_texts();
 }
 
 void jukebox::play_at_cursor()
 {
-    const tune_info& info = tune_info::tunes_list()[cursor_index()];
-    info.tune().play(1, info.loop());
+    context().playlist().play(cursor_index());
 
+    // Texts are redrawn on `playback_event::STARTED`
     _playing_index = cursor_index();
-
-    redraw_tune_head_texts();
-    redraw_a_texts();
 }
 
 void jukebox::pause_or_resume()
 {
-    if (bn::dmg_music::paused())
-        bn::dmg_music::resume();
+    auto& playback = context().playback();
+
+    // Texts are redrawn on `playback_event::PAUSED` or `playback_event::RESUMED`
+    if (playback.paused())
+        playback.resume();
     else
-        bn::dmg_music::pause();
+        playback.pause();
+}
 
-    redraw_a_texts();
+void jukebox::seek_by(int seconds)
+{
+    auto& playback = context().playback();
+    if (!_playing_index.has_value() || !playback.playing())
+        return;
+
+    // Seeks from the position in the tune, as the elapsed ticks don't wrap around on the loop point.
+    const sys::tune_metadata& metadata = tune_info::tunes_list()[_playing_index.value()].metadata();
+    const int position = metadata.position_ticks(playback.elapsed_ticks());
+    const int step_ticks = (sys::playback_service::TICKS_PER_SECOND * seconds).round_integer();
+
+    // Progress is updated from the elapsed ticks on the next frame.
+    playback.seek(metadata, position + step_ticks);
 }
 
 void jukebox::stop()
 {
     if (_playing_index.has_value())
     {
-        bn::dmg_music::stop();
-        _playing_index.reset();
+        context().config_save().flush();
 
-        redraw_tune_head_texts();
-        redraw_a_texts();
+        // Texts are redrawn on `playback_event::STOPPED`
+        context().playback().stop();
+        _playing_index.reset();
     }
 }
 
@@ -157,59 +286,261 @@ void jukebox::set_cursor_index(unsigned index)
 {
     auto& config_save = context().config_save();
 
+    // Written behind by `config_save::update()`, as this is called on every scroll step.
     config_save.set_tune_index(index);
-    config_save.save();
 
-    redraw_thumbnail_bg();
+    reserve_redraw_thumbnail_bg();
+    reserve_thumbnail_prefetches();
     redraw_a_texts();
 }
 
+void jukebox::reserve_redraw_thumbnail_bg()
+{
+    if (!_bg_painter.has_value())
+        return;
+
+    // Prefetched thumbnail is just a blit away, so no need to wait.
+    if (context().thumbnail_cache().find(get_thumbnail(cursor_index())))
+    {
+        redraw_thumbnail_bg();
+        return;
+    }
+
+    if (!_thumbnail_placeholder_shown)
+        redraw_thumbnail_placeholder_bg();
+
+    // Restart the dwell, as the cursor moved.
+    _thumbnail_dwell_frames_left = THUMBNAIL_DWELL_FRAMES;
+}
+
+void jukebox::update_thumbnail_bg()
+{
+    if (_thumbnail_dwell_frames_left != 0 && --_thumbnail_dwell_frames_left == 0)
+        redraw_thumbnail_bg();
+
+    update_thumbnail_redraw();
+}
+
+void jukebox::reserve_thumbnail_prefetches()
+{
+    const unsigned tunes_count = tune_info::tunes_list().size();
+    const unsigned next_index = (cursor_index() + 1) % tunes_count;
+    const unsigned prev_index = (cursor_index() + tunes_count - 1) % tunes_count;
+
+    // Only the adjacent ones, as the current one is drawn anyway.
+    const sys::thumbnail_item* const items[] = {
+        &get_thumbnail(next_index),
+        &get_thumbnail(prev_index),
+    };
+    context().thumbnail_cache().reserve_prefetches(items);
+}
+
+void jukebox::update_thumbnail_prefetch()
+{
+    // Only use the frames that have nothing else to do.
+    if (_thumbnail_dwell_frames_left != 0 || _thumbnail_stage != thumbnail_stage::NONE || !_tunes_navigator.idle())
+        return;
+
+    const int budget_ticks = bn::timers::ticks_per_frame() / THUMBNAIL_FRAME_BUDGET_DIVISOR;
+    context().thumbnail_cache().update_prefetch(context().bitmap_stream_buffer(), budget_ticks);
+}
+
 void jukebox::redraw_thumbnail_bg()
 {
     if (!_bg_painter.has_value())
         return;
 
+    _thumbnail_dwell_frames_left = 0;
+    _thumbnail_placeholder_shown = false;
+
+    auto& thumbnail_cache = context().thumbnail_cache();
+    const sys::thumbnail_item& thumbnail = get_thumbnail(cursor_index());
+
+    _thumbnail_cached_item = thumbnail_cache.find(thumbnail);
+    _thumbnail_streamer.reset();
+
+    // Prefetched thumbnail is already decompressed, so it's drawn at once in a single step
+    if (_thumbnail_cached_item.has_value())
+    {
+        _thumbnail_stage = thumbnail_stage::CACHED;
+        return;
+    }
+
+    // Otherwise, decompress the thumbnail strip by strip
+    // (The stream buffer is shared with the prefetch)
+    thumbnail_cache.cancel_prefetch();
+    if (thumbnail.format() == sys::thumbnail_item::format::INDEXED)
+        _thumbnail_streamer.emplace(thumbnail.indexed_item(), context().bitmap_stream_buffer());
+    else
+        _thumbnail_streamer.emplace(thumbnail.direct_item(), context().bitmap_stream_buffer());
+
     // Clear bg (excluding borders)
-    _bg_painter->unsafe_rectangle(2, 2, BG_SIZE - 3, BG_SIZE - 3, bn::colors::black);
+    _thumbnail_clear_color = bn::colors::black;
+    _thumbnail_stage = thumbnail_stage::CLEAR;
+    _thumbnail_stage_row = 2;
+}
+
+void jukebox::redraw_thumbnail_placeholder_bg()
+{
+    if (!_bg_painter.has_value())
+        return;
+
+    _thumbnail_placeholder_shown = true;
+
+    _thumbnail_cached_item.reset();
+    _thumbnail_streamer.reset();
+
+    _thumbnail_clear_color = THUMBNAIL_PLACEHOLDER_COLOR;
+    _thumbnail_stage = thumbnail_stage::CLEAR;
+    _thumbnail_stage_row = 2;
+}
+
+void jukebox::update_thumbnail_redraw()
+{
+    if (_thumbnail_stage == thumbnail_stage::NONE)
+        return;
+
+    // Painting goes to the back page, so it can be done over multiple frames, flipping only when it's complete.
+    // A step is small enough to fit in the budget, so the first one is always done, for it to progress.
+    // Another step is done only if the remaining budget fits one as long as the last one.
+    // (A prefetched thumbnail is the exception, as it's blitted as a whole in a single step)
+    bn::timer timer;
+    const int budget_ticks = bn::timers::ticks_per_frame() / THUMBNAIL_FRAME_BUDGET_DIVISOR;
+    int step_ticks;
 
-    // Draw thumbnail
-    const tune_info& info = tune_info::tunes_list()[cursor_index()];
-    const bn::direct_bitmap_item& raw_bitmap_item =
-        info.thumbnail() ? *info.thumbnail() : bn::direct_bitmap_items::no_thumbnail;
-    const bn::direct_bitmap_item bitmap_item = raw_bitmap_item.decompress(context().decompressed_bitmap_bg_colors());
+    do
+    {
+        const int step_start_ticks = timer.elapsed_ticks();
+        step_thumbnail_redraw();
+        step_ticks = timer.elapsed_ticks() - step_start_ticks;
+    } while (_thumbnail_stage != thumbnail_stage::NONE && timer.elapsed_ticks() + step_ticks <= budget_ticks);
+}
 
-    const int roi_width = std::min(BG_SIZE, bitmap_item.dimensions().width());
-    const int roi_height = std::min(BG_SIZE, bitmap_item.dimensions().height());
-    const int roi_x = (bitmap_item.dimensions().width() - roi_width) / 2;
-    const int roi_y = (bitmap_item.dimensions().height() - roi_height) / 2;
-    const bn::direct_bitmap_roi roi(bitmap_item, roi_x, roi_y, roi_width, roi_height);
+void jukebox::step_thumbnail_redraw()
+{
+    switch (_thumbnail_stage)
+    {
+    case thumbnail_stage::CACHED:
+        redraw_cached_thumbnail(*_thumbnail_cached_item);
+
+        _thumbnail_stage = thumbnail_stage::NONE;
+        _thumbnail_cached_item.reset();
+        break;
+
+    case thumbnail_stage::CLEAR: {
+        // Clear bg (excluding borders)
+        const int bottom = std::min(_thumbnail_stage_row + THUMBNAIL_CLEAR_STEP_ROWS, BG_SIZE - 2);
+        sys::bitmap_kernels::fill_rect(sys::bitmap_kernels::dp_back_page(*_bg_painter), 2, _thumbnail_stage_row,
+                                       BG_SIZE - 4, bottom - _thumbnail_stage_row, _thumbnail_clear_color);
+        _thumbnail_stage_row = bottom;
+
+        if (bottom >= BG_SIZE - 2)
+        {
+            _thumbnail_stage = _thumbnail_streamer.has_value() ? thumbnail_stage::BLIT : thumbnail_stage::BORDERS;
+            _thumbnail_stage_row = 0;
+        }
+        break;
+    }
+
+    case thumbnail_stage::BLIT:
+        if (step_thumbnail_blit())
+            _thumbnail_stage = thumbnail_stage::BORDERS;
+        break;
+
+    case thumbnail_stage::BORDERS:
+        redraw_thumbnail_borders();
+
+        // Apply changes
+        _bg_painter->flip_page_later();
+
+        _thumbnail_stage = thumbnail_stage::NONE;
+        _thumbnail_streamer.reset();
+        break;
+
+    default:
+        BN_ERROR("Invalid thumbnail stage: ", (int)_thumbnail_stage);
+    }
+}
+
+bool jukebox::step_thumbnail_blit()
+{
+    // Draw thumbnail, decompressing a strip
+    sys::bitmap_streamer& streamer = *_thumbnail_streamer;
+
+    const int roi_width = std::min(BG_SIZE, streamer.dimensions().width());
+    const int roi_height = std::min(BG_SIZE, streamer.dimensions().height());
+    const int roi_x = (streamer.dimensions().width() - roi_width) / 2;
+    const int roi_y = (streamer.dimensions().height() - roi_height) / 2;
 
     const int x = (BG_SIZE - roi_width) / 2;
     const int y = (BG_SIZE - roi_height) / 2;
-    _bg_painter->unsafe_blit(x, y, roi);
 
-    // Draw inner borders
-    _bg_painter->unsafe_horizontal_line(1, BG_SIZE - 2, 1, bn::colors::black);
-    _bg_painter->unsafe_vertical_line(1, 1, BG_SIZE - 2, bn::colors::black);
-    _bg_painter->unsafe_vertical_line(BG_SIZE - 2, 1, BG_SIZE - 2, bn::colors::black);
-    _bg_painter->unsafe_horizontal_line(1, BG_SIZE - 2, BG_SIZE - 2, bn::colors::black);
+    const int row_bytes = streamer.dimensions().width() * (streamer.indexed() ? 1 : int(sizeof(bn::color)));
+    const int max_rows = std::max(1, THUMBNAIL_BLIT_STEP_BYTES / row_bytes);
+
+    const int strip_y = streamer.streamed_rows();
+    const sys::thumbnail_item strip = streamer.indexed()
+                                          ? sys::thumbnail_item(streamer.next_indexed_strip(max_rows))
+                                          : sys::thumbnail_item(streamer.next_strip(max_rows));
+
+    // Blit the rows of the strip that are in the ROI
+    const int top = std::max(strip_y, roi_y);
+    const int bottom = std::min(strip_y + strip.dimensions().height(), roi_y + roi_height);
+    if (top < bottom)
+    {
+        blit_thumbnail_rows(sys::bitmap_kernels::dp_back_page(*_bg_painter), strip, roi_x, top - strip_y, x,
+                            y + top - roi_y, roi_width, bottom - top);
+    }
+
+    // Rows below the ROI aren't decompressed at all.
+    return streamer.done() || streamer.streamed_rows() >= roi_y + roi_height;
+}
+
+void jukebox::redraw_cached_thumbnail(const sys::thumbnail_item& thumbnail)
+{
+    std::uint16_t* page = sys::bitmap_kernels::dp_back_page(*_bg_painter);
 
-    // Draw outer borders
-    _bg_painter->unsafe_horizontal_line(0, BG_SIZE - 1, 0, bn::colors::gray);
-    _bg_painter->unsafe_vertical_line(0, 0, BG_SIZE - 1, bn::colors::gray);
-    _bg_painter->unsafe_vertical_line(BG_SIZE - 1, 0, BG_SIZE - 1, bn::colors::gray);
-    _bg_painter->unsafe_horizontal_line(0, BG_SIZE - 1, BG_SIZE - 1, bn::colors::gray);
+    const bn::size dimensions = thumbnail.dimensions();
+    const int left = (BG_SIZE - dimensions.width()) / 2;
+    const int top = (BG_SIZE - dimensions.height()) / 2;
+    const int right = left + dimensions.width();
+    const int bottom = top + dimensions.height();
+
+    // Clear only the margins around the thumbnail (excluding borders)
+    if (top > 2)
+        sys::bitmap_kernels::fill_rect(page, 2, 2, BG_SIZE - 4, top - 2, bn::colors::black);
+    if (bottom < BG_SIZE - 2)
+        sys::bitmap_kernels::fill_rect(page, 2, bottom, BG_SIZE - 4, BG_SIZE - 2 - bottom, bn::colors::black);
+    if (left > 2)
+        sys::bitmap_kernels::fill_rect(page, 2, top, left - 2, dimensions.height(), bn::colors::black);
+    if (right < BG_SIZE - 2)
+        sys::bitmap_kernels::fill_rect(page, right, top, BG_SIZE - 2 - right, dimensions.height(), bn::colors::black);
+
+    // Cached thumbnail is already cropped
+    blit_thumbnail_rows(page, thumbnail, 0, 0, left, top, dimensions.width(), dimensions.height());
+
+    redraw_thumbnail_borders();
 
     // Apply changes
     _bg_painter->flip_page_later();
 }
 
+void jukebox::redraw_thumbnail_borders()
+{
+    // Draw outer & inner borders
+    sys::bitmap_kernels::draw_frame(sys::bitmap_kernels::dp_back_page(*_bg_painter), 0, 0, BG_SIZE, BG_SIZE,
+                                    bn::colors::gray, bn::colors::black);
+}
+
 void jukebox::redraw_tune_head_texts()
 {
     _tune_head_text_sprites.clear();
 
     if (!_playing_index.has_value())
+    {
+        _progress.hide();
         return;
+    }
 
     auto& ctx = context();
     auto& text_gens = ctx.text_generators();
@@ -227,6 +558,9 @@ void jukebox::redraw_tune_head_texts()
 
     const tune_info& info = tune_info::tunes_list()[_playing_index.value()];
 
+    // "0:42/2:40", which is generated before the tune name, so that the tune name can avoid it.
+    _progress.show(info.metadata(), ctx.playback().elapsed_ticks(), TIME_TOP_RIGHT_POS, PROGRESS_BAR_TOP);
+
     [[maybe_unused]] bool generated;
     bn::fixed_point text_pos(TUNE_NAME_POS);
 
@@ -243,8 +577,16 @@ void jukebox::redraw_tune_head_texts()
         text_pos.set_x(text_pos.x() + big_text_gen.width(str) + big_text_gen.width(" "));
     }
 
-    // "Playing tune name"
-    generated = big_text_gen.generate_top_left_optional(text_pos, info.tune_name(), _tune_head_text_sprites);
+    // "Playing tune name", which is cut with "…" if it's too long
+    static constexpr int TIME_MARGIN = 4;
+    const int name_max_width = _progress.time_left() - TIME_MARGIN - text_pos.x().ceil_integer();
+    const bn::string_view tune_name = fit_text(big_text_gen, info.tune_name(), name_max_width);
+    generated = big_text_gen.generate_top_left_optional(text_pos, tune_name, _tune_head_text_sprites);
+    if (tune_name.size() != info.tune_name().size())
+    {
+        text_pos.set_x(text_pos.x() + big_text_gen.width(tune_name));
+        generated = big_text_gen.generate_top_left_optional(text_pos, "…", _tune_head_text_sprites);
+    }
 
     // "☻ "
     text_pos = COMPOSER_NAME_POS;
@@ -286,49 +628,67 @@ void jukebox::redraw_a_texts()
     const bn::string_view text = _state == state::TUNE_INFO ? " Next"
                                  : (!_playing_index.has_value() || _playing_index.value() != cursor_index())
                                      ? " Play"
-                                 : bn::dmg_music::paused() ? " Resume"
-                                                           : " Pause";
+                                 : context().playback().paused() ? " Resume"
+                                                                 : " Pause";
 
     [[maybe_unused]] bool generated = text_gen.generate_top_left_optional(TEXT_POS, text, _a_text_sprites);
 }
 
-void jukebox::redraw_b_texts()
+void jukebox::redraw_fixed_texts()
 {
-    _b_text_sprites.clear();
+    arena().release();
 
-    auto& text_gen = context().text_generators().get(sys::text_generators::font::GALMURI_9);
+    auto& text_gens = context().text_generators();
+    auto& big_text_gen = text_gens.get(sys::text_generators::font::GALMURI_9);
+    auto& small_text_gen = text_gens.get(sys::text_generators::font::GALMURI_7);
 
-    static constexpr bn::fixed_point TEXT_POS(RIGHT_BTN_X, TOP_BTN_Y);
-    const bn::string_view text = _state == state::TUNE_INFO ? " Skip" : " Stop";
+    [[maybe_unused]] bool generated;
 
-    [[maybe_unused]] bool generated = text_gen.generate_top_left_optional(TEXT_POS, text, _b_text_sprites);
-}
+    // B
+    {
+        static constexpr bn::fixed_point TEXT_POS(RIGHT_BTN_X, TOP_BTN_Y);
+        const bn::string_view text = _state == state::TUNE_INFO ? " Skip" : " Stop";
 
-void jukebox::redraw_start_texts()
-{
-    _start_text_sprites.clear();
+        generated = big_text_gen.generate_top_left_optional(TEXT_POS, text, arena().sprites());
+    }
 
+    // START
     if (_state != state::TUNE_INFO)
     {
-        auto& text_gen = context().text_generators().get(sys::text_generators::font::GALMURI_7);
-
         static constexpr bn::fixed_point TEXT_POS(LEFT_BTN_X, BOTTOM_BTN_Y);
         static constexpr bn::string_view TEXT = " Info";
 
-        [[maybe_unused]] bool generated = text_gen.generate_top_left_optional(TEXT_POS, TEXT, _start_text_sprites);
+        generated = small_text_gen.generate_top_left_optional(TEXT_POS, TEXT, arena().sprites());
+    }
+
+    // SELECT
+    {
+        static constexpr bn::fixed_point TEXT_POS(RIGHT_BTN_X, BOTTOM_BTN_Y);
+        static constexpr bn::string_view TEXT = " License";
+
+        generated = small_text_gen.generate_top_left_optional(TEXT_POS, TEXT, arena().sprites());
     }
 }
 
-void jukebox::redraw_select_texts()
+void jukebox::redraw_playlist_texts()
 {
-    _select_text_sprites.clear();
+    _playlist_text_sprites.clear();
 
+    const auto& playlist = context().playlist();
     auto& text_gen = context().text_generators().get(sys::text_generators::font::GALMURI_7);
 
-    static constexpr bn::fixed_point TEXT_POS(RIGHT_BTN_X, BOTTOM_BTN_Y);
-    static constexpr bn::string_view TEXT = " License";
+    bn::string<24> str;
+    bn::ostringstream oss(str);
+    oss << (playlist.repeat() == sys::repeat_mode::ONE   ? "Repeat 1"
+            : playlist.repeat() == sys::repeat_mode::ALL ? "Repeat"
+                                                         : "Once");
+    if (playlist.shuffle())
+        oss << " Shuffle";
+
+    // Right aligned on the composer row
+    const bn::fixed_point text_pos(bn::display::width() - 2 - text_gen.width(str), 16);
 
-    [[maybe_unused]] bool generated = text_gen.generate_top_left_optional(TEXT_POS, TEXT, _select_text_sprites);
+    [[maybe_unused]] bool generated = text_gen.generate_top_left_optional(text_pos, str, _playlist_text_sprites);
 }
 
 void jukebox::redraw_tune_list_texts()
@@ -358,19 +718,49 @@ void jukebox::on_tunes_navigator_cancelled()
     stop();
 }
 
+void jukebox::on_playback_event(sys::playback_event event)
+{
+    switch (event)
+    {
+    case sys::playback_event::STARTED:
+        // Might be the next tune of the playlist
+        _playing_index = context().playback().track_id();
+        break;
+
+    case sys::playback_event::END_OF_TRACK:
+        _playing_index.reset();
+        break;
+
+    case sys::playback_event::LOOP_POINT:
+        return;
+
+    default:
+        break;
+    }
+
+    // Covered texts are redrawn all together on `uncover()`
+    if (!_covered)
+    {
+        redraw_tune_head_texts();
+        redraw_a_texts();
+    }
+}
+
 auto jukebox::init_tunes_navigator() -> ui::menu_navigator
 {
     // Fix out-of-bound tune index
     if (cursor_index() >= static_cast<unsigned>(tune_info::tunes_list().size()))
         set_cursor_index(0);
 
-    return ui::menu_navigator_builder(sys::text_generators::font::GALMURI_7, tune_info::tunes_names_list(),
-                                      _list_text_sprites)
+    return ui::menu_navigator_builder(sys::text_generators::font::GALMURI_7, tune_info::tunes_names_list())
         .set_pointed_index(cursor_index())
         .set_max_lines(ui::menu_navigator::MAX_MENUS_COUNT)
         .set_line_margin(4)
         .set_scroll_start_delay(20)
         .set_scroll_continue_delay(5)
+        .set_lines_per_frame(3)
+        .set_list_mode(ui::menu_navigator::list_mode::SCROLL)
+        .set_text_sprite_cache(&context().text_sprite_cache())
         .set_top_left_position(bn::fixed_point(LEFT_BTN_X, BG_POS.y()))
         .set_pointed_changed_callback(
             [this](unsigned prev_page, unsigned prev_pointed_index, unsigned new_page, unsigned new_pointed_index) {
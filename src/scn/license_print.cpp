@@ -4,8 +4,13 @@
 #include "scn/scene_context.h"
 #include "scn/scene_stack.h"
 
+#include <bn_assert.h>
 #include <bn_display.h>
 #include <bn_keypad.h>
+#include <bn_sstream.h>
+#include <bn_string.h>
+#include <bn_timer.h>
+#include <bn_timers.h>
 
 namespace jb::scn
 {
@@ -17,44 +22,167 @@ constexpr auto FONT = sys::text_generators::font::GALMURI_7;
 
 constexpr bn::fixed_point TEXT_TOP_LEFT_POS(10, 10);
 constexpr bn::fixed LINE_SPACING = 10;
-constexpr int MAX_LINES = 14;
 
-} // namespace
+// Pages are wrapped to this width by `misc_writer.py`.
+constexpr int LINE_WIDTH = bn::display::width() - 2 * TEXT_TOP_LEFT_POS.x().ceil_integer();
 
-license_print::license_print(int license_idx, scene_context& ctx)
-    : scene(ctx), _typewriter(ctx.text_generators().get(FONT)), _license_idx(license_idx)
-{
-    auto& gens = ctx.text_generators();
-    auto& gen = gens.get(FONT);
+/// Instant printing can use up to `1 / INSTANT_FRAME_BUDGET_DIVISOR` of a frame.
+constexpr int INSTANT_FRAME_BUDGET_DIVISOR = 4;
 
-    const auto prev_color = gens.text_color(FONT);
-    const auto prev_alignment = gen.alignment();
-    gen.set_left_alignment();
+constexpr bn::fixed PAGE_NUM_TOP = TEXT_TOP_LEFT_POS.y() + gen::LICENSE_PAGE_LINES * LINE_SPACING + 1;
 
-    _typewriter.start(TEXT_TOP_LEFT_POS, gen::LICENSE_CONTENTS[_license_idx], _text_sprites, 1, nullptr,
-                      (bn::display::width() - 2 * TEXT_TOP_LEFT_POS.x()).ceil_integer(), LINE_SPACING, MAX_LINES);
+} // namespace
 
-    gen.set_alignment(prev_alignment);
-    gens.set_text_color(FONT, prev_color);
+license_print::license_print(int license_idx, scene_context& ctx)
+    : scene(ctx, _sprites_arena), _typewriter(ctx.text_generators().get(FONT)), _license_idx(license_idx)
+{
+    print_page(0, print_mode::TYPEWRITER);
 }
 
 bool license_print::update()
 {
-    if (_typewriter.done())
+    const int pages_count = gen::LICENSE_CONTENTS[_license_idx].blocks_count();
+
+    // Flipped pages are printed instantly, as the user is looking for something.
+    if (bn::keypad::l_pressed() || bn::keypad::up_pressed())
+    {
+        if (_page_idx > 0)
+            print_page(_page_idx - 1, print_mode::INSTANT);
+    }
+    else if (bn::keypad::r_pressed() || bn::keypad::down_pressed())
+    {
+        if (_page_idx < pages_count - 1)
+            print_page(_page_idx + 1, print_mode::INSTANT);
+    }
+    else if (page_printed())
     {
         if (bn::keypad::a_pressed() || bn::keypad::b_pressed())
         {
             auto& state_stack = context().stack();
 
-            state_stack.reserve_replace_top_with_delay<licenses_list>(_license_idx, context());
+            state_stack.reserve_resume_replace_top_with_delay<licenses_list>(_license_idx, context());
         }
     }
-    else
+    else if (bn::keypad::a_pressed() || bn::keypad::b_pressed())
+    {
+        skip_printing();
+    }
+    else if (_print_mode == print_mode::TYPEWRITER)
     {
         _typewriter.update();
     }
+    else
+    {
+        print_lines(true);
+    }
 
     return false;
 }
 
+void license_print::print_page(int page_idx, print_mode mode)
+{
+    const sys::compressed_text& text = gen::LICENSE_CONTENTS[_license_idx];
+    BN_ASSERT(page_idx >= 0 && page_idx < text.blocks_count(), "Invalid page idx: ", page_idx);
+
+    _page_idx = page_idx;
+    _print_mode = mode;
+    _printed_bytes = 0;
+    _printed_lines = 0;
+
+    // Each block is a page, so jumping to any page only decompresses that page.
+    _page_bytes = text.decompress_block(page_idx, bn::span<char>(_page_text.data(), _page_text.size()));
+
+    auto& gens = context().text_generators();
+    auto& gen = gens.get(FONT);
+
+    const auto prev_color = gens.text_color(FONT);
+    const auto prev_alignment = gen.alignment();
+    gen.set_left_alignment();
+
+    arena().release();
+
+    // "2/5"
+    if (text.blocks_count() > 1)
+    {
+        bn::string<8> str;
+        bn::ostringstream oss(str);
+        oss << (page_idx + 1) << '/' << text.blocks_count();
+
+        const bn::fixed_point pos(bn::display::width() - TEXT_TOP_LEFT_POS.x() - gen.width(str), PAGE_NUM_TOP);
+        gen.generate_top_left(pos, str, arena().sprites());
+    }
+
+    // Text sprites are allocated after the page number, so that skipping can release only them.
+    _text_mark = arena().mark();
+    if (mode == print_mode::TYPEWRITER)
+    {
+        _typewriter.start(TEXT_TOP_LEFT_POS, bn::string_view(_page_text.data(), _page_bytes), arena().sprites(), 1,
+                          nullptr, LINE_WIDTH, LINE_SPACING, gen::LICENSE_PAGE_LINES);
+    }
+
+    gen.set_alignment(prev_alignment);
+    gens.set_text_color(FONT, prev_color);
+
+    if (mode == print_mode::INSTANT)
+        print_lines(true);
+}
+
+void license_print::skip_printing()
+{
+    if (_print_mode == print_mode::TYPEWRITER)
+    {
+        // Typewriter can't resume from the middle of a line, so the page is generated again from the start.
+        arena().release_to(_text_mark);
+        _print_mode = print_mode::INSTANT;
+        _printed_bytes = 0;
+        _printed_lines = 0;
+    }
+
+    print_lines(false);
+}
+
+void license_print::print_lines(bool budgeted)
+{
+    BN_ASSERT(_print_mode == print_mode::INSTANT, "Invalid print mode: ", (int)_print_mode);
+
+    auto& gens = context().text_generators();
+    auto& gen = gens.get(FONT);
+
+    const auto prev_color = gens.text_color(FONT);
+    const auto prev_alignment = gen.alignment();
+    gen.set_left_alignment();
+
+    const int budget_ticks = bn::timers::ticks_per_frame() / INSTANT_FRAME_BUDGET_DIVISOR;
+    bn::timer timer;
+
+    // Pages are already wrapped, so each line is generated as it is.
+    do
+    {
+        int line_end = _printed_bytes;
+        while (line_end < _page_bytes && _page_text[line_end] != '\n')
+            ++line_end;
+
+        const bn::string_view line(_page_text.data() + _printed_bytes, line_end - _printed_bytes);
+        if (!line.empty())
+        {
+            const bn::fixed_point pos(TEXT_TOP_LEFT_POS.x(), TEXT_TOP_LEFT_POS.y() + _printed_lines * LINE_SPACING);
+            gen.generate_top_left(pos, line, arena().sprites());
+        }
+
+        _printed_bytes = line_end + 1;
+        ++_printed_lines;
+    } while (!page_printed() && (!budgeted || timer.elapsed_ticks() < budget_ticks));
+
+    gen.set_alignment(prev_alignment);
+    gens.set_text_color(FONT, prev_color);
+}
+
+bool license_print::page_printed() const
+{
+    if (_print_mode == print_mode::TYPEWRITER)
+        return _typewriter.done();
+
+    return _printed_bytes >= _page_bytes;
+}
+
 } // namespace jb::scn
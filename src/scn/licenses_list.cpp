@@ -34,24 +34,58 @@ constexpr auto get_pos(int license_idx) -> bn::fixed_point
 
 } // namespace
 
-licenses_list::licenses_list(int license_idx, scene_context& ctx) : scene(ctx), _cursor_idx(license_idx)
+licenses_list::licenses_list(int license_idx, scene_context& ctx) : scene(ctx, _names_arena), _cursor_idx(license_idx)
 {
-    auto& gens = ctx.text_generators();
+}
+
+void licenses_list::hibernate()
+{
+    // Names are generated again by `load_step()` on resume.
+    arena().release();
+    _generated_names_count = 0;
+}
+
+bool licenses_list::load_step()
+{
+    // A name per step, so that `scene_stack` can spread them over frames.
+    // Names are hidden until all of them are generated, so that they don't pop in over the previous scene.
+    if (_generated_names_count < gen::LICENSE_NAMES.size())
+    {
+        const int license_idx = _generated_names_count++;
+        generate_name(license_idx);
+
+        for (int spr_idx = _name_start_idxes[license_idx]; spr_idx < _name_start_idxes[license_idx + 1]; ++spr_idx)
+            arena().sprites()[spr_idx].set_visible(false);
+    }
+
+    const bool loaded = _generated_names_count == gen::LICENSE_NAMES.size();
+    if (loaded)
+    {
+        for (bn::sprite_ptr& sprite : arena().sprites())
+            sprite.set_visible(true);
+    }
+
+    return loaded;
+}
+
+void licenses_list::generate_name(int license_idx)
+{
+    auto& gens = context().text_generators();
     auto& gen = gens.get(FONT);
+    auto& names_sprites = arena().sprites();
 
     const auto prev_color = gens.text_color(FONT);
     const auto prev_alignment = gen.alignment();
     gen.set_left_alignment();
 
-    for (int idx = 0; idx < gen::LICENSE_NAMES.size(); ++idx)
-    {
-        _name_start_idxes[idx] = static_cast<std::uint8_t>(_names_sprites.size());
+    // Names are generated in order, so each one ends where the next one starts.
+    _name_start_idxes[license_idx] = static_cast<std::uint8_t>(names_sprites.size());
 
-        gens.set_text_color(FONT, idx == _cursor_idx ? sys::TEXT_HIGHLIGHT_COLOR : sys::TEXT_NORMAL_COLOR);
+    gens.set_text_color(FONT, license_idx == _cursor_idx ? sys::TEXT_HIGHLIGHT_COLOR : sys::TEXT_NORMAL_COLOR);
 
-        gen.generate_top_left(get_pos(idx), gen::LICENSE_NAMES[idx], _names_sprites);
-    }
-    _name_start_idxes.back() = static_cast<std::uint8_t>(_names_sprites.size());
+    gen.generate_top_left(get_pos(license_idx), gen::LICENSE_NAMES[license_idx], names_sprites);
+
+    _name_start_idxes[license_idx + 1] = static_cast<std::uint8_t>(names_sprites.size());
 
     gen.set_alignment(prev_alignment);
     gens.set_text_color(FONT, prev_color);
@@ -81,7 +115,8 @@ bool licenses_list::update()
     {
         auto& scene_stack = context().stack();
 
-        scene_stack.reserve_replace_top<license_print>(_cursor_idx, context());
+        // Names are released in hibernation, as `license_print` can fill all the sprite items with its own arena.
+        scene_stack.reserve_hibernate_replace_top<license_print>(_cursor_idx, context());
     }
     else if (bn::keypad::b_pressed())
     {
@@ -104,7 +139,7 @@ void licenses_list::recolor_license(int license_idx)
     colors[1] = license_idx == _cursor_idx ? sys::TEXT_HIGHLIGHT_COLOR : sys::TEXT_NORMAL_COLOR;
 
     for (int spr_idx = _name_start_idxes[license_idx]; spr_idx < _name_start_idxes[license_idx + 1]; ++spr_idx)
-        _names_sprites[spr_idx].set_palette(bn::sprite_palette_item(colors, bn::bpp_mode::BPP_4));
+        arena().sprites()[spr_idx].set_palette(bn::sprite_palette_item(colors, bn::bpp_mode::BPP_4));
 }
 
 } // namespace jb::scn
@@ -0,0 +1,35 @@
+#include "scn/scene_arena.h"
+
+#include <bn_assert.h>
+
+namespace jb::scn
+{
+
+auto scene_arena::sprites() -> bn::ivector<bn::sprite_ptr>&
+{
+    return _sprites;
+}
+
+auto scene_arena::sprites() const -> const bn::ivector<bn::sprite_ptr>&
+{
+    return _sprites;
+}
+
+int scene_arena::mark() const
+{
+    return _sprites.size();
+}
+
+void scene_arena::release_to(int mark)
+{
+    BN_ASSERT(mark >= 0 && mark <= _sprites.size(), "Invalid mark: ", mark);
+
+    _sprites.erase(_sprites.begin() + mark, _sprites.end());
+}
+
+void scene_arena::release()
+{
+    release_to(0);
+}
+
+} // namespace jb::scn
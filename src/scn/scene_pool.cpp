@@ -0,0 +1,110 @@
+#include "scn/scene_pool.h"
+
+#include "dev/dev_counters.h"
+
+#include <bn_assert.h>
+
+#include <algorithm>
+
+namespace jb::scn
+{
+
+scene_pool::scene_pool()
+{
+    int slot_idx = 0;
+    int offset = 0;
+
+    for (int class_idx = 0; class_idx < SIZE_CLASSES_COUNT; ++class_idx)
+    {
+        const scene_size_class& size_class = SCENE_SIZE_CLASSES[class_idx];
+        const int slot_bytes = (size_class.bytes + MAX_SCENE_ALIGN - 1) / MAX_SCENE_ALIGN * MAX_SCENE_ALIGN;
+
+        for (int i = 0; i < size_class.slots_count; ++i, ++slot_idx)
+        {
+            _slots[slot_idx] = slot{offset, slot_bytes, static_cast<std::uint8_t>(class_idx), 0};
+            offset += slot_bytes;
+        }
+    }
+}
+
+void scene_pool::destroy(scene& scene_)
+{
+    const std::byte* address = reinterpret_cast<const std::byte*>(&scene_);
+
+    for (slot& slot_ : _slots)
+    {
+        if (address >= _buffer + slot_.offset && address < _buffer + slot_.offset + slot_.bytes)
+        {
+            BN_ASSERT(slot_.scene_bytes != 0, "Scene already destroyed");
+
+            scene_.~scene();
+
+            _used_bytes -= slot_.scene_bytes;
+            --_used_slots[slot_.size_class_idx];
+            slot_.scene_bytes = 0;
+            return;
+        }
+    }
+
+    BN_ERROR("Scene is not from this pool");
+}
+
+auto scene_pool::allocate(int bytes) -> std::byte*
+{
+    slot* best = nullptr;
+
+    // Smallest free slot that fits
+    for (slot& slot_ : _slots)
+    {
+        if (slot_.scene_bytes == 0 && slot_.bytes >= bytes && (!best || slot_.bytes < best->bytes))
+            best = &slot_;
+    }
+
+    BN_ASSERT(best, "No free scene slot for ", bytes, " bytes, increase slots in SCENE_SIZE_CLASSES");
+
+    best->scene_bytes = bytes;
+
+    const int class_idx = best->size_class_idx;
+    ++_used_slots[class_idx];
+    _max_used_slots[class_idx] = std::max(_max_used_slots[class_idx], _used_slots[class_idx]);
+
+    _used_bytes += bytes;
+    if (_used_bytes > _max_used_bytes)
+    {
+        _max_used_bytes = _used_bytes;
+
+        if constexpr (JB_DEVBUILD)
+        {
+            dev::set_counter(dev::counter::SCENE_POOL_MAX_USED_BYTES, _max_used_bytes);
+            dev::log_counter(dev::counter::SCENE_POOL_MAX_USED_BYTES);
+        }
+    }
+
+    return _buffer + best->offset;
+}
+
+int scene_pool::used_bytes() const
+{
+    return _used_bytes;
+}
+
+int scene_pool::max_used_bytes() const
+{
+    return _max_used_bytes;
+}
+
+int scene_pool::used_slots(int size_class_idx) const
+{
+    BN_ASSERT(size_class_idx >= 0 && size_class_idx < SIZE_CLASSES_COUNT, "Invalid size class idx: ", size_class_idx);
+
+    return _used_slots[size_class_idx];
+}
+
+int scene_pool::max_used_slots(int size_class_idx) const
+{
+    BN_ASSERT(size_class_idx >= 0 && size_class_idx < SIZE_CLASSES_COUNT, "Invalid size class idx: ", size_class_idx);
+
+    return _max_used_slots[size_class_idx];
+}
+
+} // namespace jb::scn
@@ -3,7 +3,7 @@
 namespace jb::scn
 {
 
-scene_deleter::scene_deleter(scene_pool_t& pool) : _pool(&pool)
+scene_deleter::scene_deleter(scene_pool& pool) : _pool(&pool)
 {
 }
 
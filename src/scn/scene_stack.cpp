@@ -1,31 +1,55 @@
 #include "scn/scene_stack.h"
 
+#include "dev/sprite_tiles_probe.h"
+
 #include "ibn_stats.h"
 
 #include <bn_core.h>
+#include <bn_timer.h>
+#include <bn_timers.h>
+
+#include <utility>
 
 namespace jb::scn
 {
 
+namespace
+{
+
+/// Scene loading can use up to `1 / LOAD_FRAME_BUDGET_DIVISOR` of a frame.
+constexpr int LOAD_FRAME_BUDGET_DIVISOR = 2;
+
+} // namespace
+
 void scene_stack::update()
 {
+    if (loading())
+    {
+        step_loading();
+
+        if (loading())
+            return;
+    }
+
     // Update scenes
     for (auto iter = _scenes.rbegin(); iter != _scenes.rend(); ++iter)
     {
         // Break if the upper scene don't want to update the scene below
-        if (!(*iter)->update())
+        if (!iter->ptr->update())
             break;
     }
 
     // Apply reserved changes
-    for (auto& reserved : _reserved_changes)
+    for (int change_idx = 0; change_idx < _reserved_changes.size(); ++change_idx)
     {
+        reserved_change& reserved = _reserved_changes[change_idx];
+
         switch (reserved.change_kind)
         {
         case reserved_change::kind::PUSH:
             // Previous top scene is `cover()`ed first
             if (!_scenes.empty())
-                _scenes.back()->cover(reserved.new_scene_type);
+                _scenes.back().ptr->cover(reserved.new_scene_type);
 
             if (reserved.delay_frame)
             {
@@ -33,10 +57,11 @@ void scene_stack::update()
                 IBN_STATS_UPDATE;
             }
 
-            _scenes.push_back(reserved.new_scene_factory(*this));
+            push_new_or_resumed(reserved);
             break;
 
         case reserved_change::kind::POP:
+            destroy_scene(_scenes.back());
             _scenes.pop_back();
 
             if (reserved.delay_frame)
@@ -47,13 +72,16 @@ void scene_stack::update()
 
             // Next top scene is `uncover()`ed last
             if (!_scenes.empty())
-                _scenes.back()->uncover();
+                _scenes.back().ptr->uncover();
             break;
 
         case reserved_change::kind::REPLACE_TOP:
             // Avoids `uncover()` & `cover()` overhead
             if (!_scenes.empty())
+            {
+                destroy_scene(_scenes.back());
                 _scenes.pop_back();
+            }
 
             if (reserved.delay_frame)
             {
@@ -61,37 +89,128 @@ void scene_stack::update()
                 IBN_STATS_UPDATE;
             }
 
-            _scenes.push_back(reserved.new_scene_factory(*this));
+            push_new_or_resumed(reserved);
+            break;
+
+        case reserved_change::kind::HIBERNATE_REPLACE_TOP:
+            if (!_scenes.empty())
+            {
+                // Oldest hibernated scene is destroyed to make room
+                if (_hibernated_scenes.full())
+                {
+                    destroy_scene(_hibernated_scenes.front());
+                    _hibernated_scenes.erase(_hibernated_scenes.begin());
+                }
+
+                _hibernated_scenes.push_back(std::move(_scenes.back()));
+                _scenes.pop_back();
+                _hibernated_scenes.back().ptr->hibernate();
+            }
+
+            push_new_or_resumed(reserved);
             break;
 
         case reserved_change::kind::CLEAR:
             // Avoids `uncover()` overhead
             while (!_scenes.empty())
+            {
+                destroy_scene(_scenes.back());
                 _scenes.pop_back();
+            }
+            for (scene_entry& hibernated : _hibernated_scenes)
+                destroy_scene(hibernated);
+            _hibernated_scenes.clear();
             break;
 
         default:
             BN_ERROR("Invalid reserved_change::kind : ", (int)reserved.change_kind);
         }
+
+        // Rest of the changes are applied after the new scene is loaded
+        if (loading())
+        {
+            _reserved_changes.erase(_reserved_changes.begin(), _reserved_changes.begin() + change_idx + 1);
+            return;
+        }
     }
     _reserved_changes.clear();
 }
 
+bool scene_stack::loading() const
+{
+    return static_cast<bool>(_loading_scene.ptr);
+}
+
+void scene_stack::push_new_or_resumed(reserved_change& reserved)
+{
+    for (auto iter = _hibernated_scenes.begin(); iter != _hibernated_scenes.end(); ++iter)
+    {
+        if (iter->type == reserved.new_scene_type)
+        {
+            // Resources released in hibernation are rebuilt under the frame budget, just like a new scene.
+            if (reserved.resume_hibernated)
+            {
+                _loading_scene = std::move(*iter);
+                _hibernated_scenes.erase(iter);
+                step_loading();
+                return;
+            }
+
+            // Constructed with the new arguments instead, so the stale one is never resumed.
+            destroy_scene(*iter);
+            _hibernated_scenes.erase(iter);
+            break;
+        }
+    }
+
+    _loading_scene = scene_entry{reserved.new_scene_type, reserved.new_scene_factory(*this)};
+    step_loading();
+}
+
+void scene_stack::step_loading()
+{
+    BN_ASSERT(loading(), "No scene is loading");
+
+    const int budget_ticks = bn::timers::ticks_per_frame() / LOAD_FRAME_BUDGET_DIVISOR;
+    bn::timer timer;
+
+    bool loaded;
+    do
+    {
+        loaded = _loading_scene.ptr->load_step();
+    } while (!loaded && timer.elapsed_ticks() < budget_ticks);
+
+    if (loaded)
+    {
+        _scenes.push_back(std::move(_loading_scene));
+    }
+}
+
+void scene_stack::destroy_scene(scene_entry& entry)
+{
+    // Sprites are released before the other members of the scene, which might still refer to them.
+    entry.ptr->_arena.release();
+    entry.ptr.reset();
+
+    if constexpr (JB_DEVBUILD)
+        dev::log_sprite_tiles_fragmentation();
+}
+
 void scene_stack::reserve_pop()
 {
-    _reserved_changes.emplace_back(reserved_change::kind::POP, false, bn::type_id_t{},
+    _reserved_changes.emplace_back(reserved_change::kind::POP, false, false, bn::type_id_t{},
                                    reserved_change::new_scene_factory_t{});
 }
 
 void scene_stack::reserve_pop_with_delay()
 {
-    _reserved_changes.emplace_back(reserved_change::kind::POP, true, bn::type_id_t{},
+    _reserved_changes.emplace_back(reserved_change::kind::POP, true, false, bn::type_id_t{},
                                    reserved_change::new_scene_factory_t{});
 }
 
 void scene_stack::reserve_clear()
 {
-    _reserved_changes.emplace_back(reserved_change::kind::CLEAR, false, bn::type_id_t{},
+    _reserved_changes.emplace_back(reserved_change::kind::CLEAR, false, false, bn::type_id_t{},
                                    reserved_change::new_scene_factory_t{});
 }
 
@@ -0,0 +1,173 @@
+#include "sys/bitmap_kernels.h"
+
+#include <bn_assert.h>
+#include <bn_bitmap_bg.h>
+#include <bn_memory.h>
+
+namespace jb::sys::bitmap_kernels
+{
+
+namespace
+{
+
+constexpr int PAGE_STRIDE = bn::bitmap_bg::dp_direct_width();
+
+[[gnu::always_inline]] inline void fill_span(std::uint16_t* dst, int count, std::uint16_t value)
+{
+    if (count <= 0)
+        return;
+
+    // Align to a word.
+    if (reinterpret_cast<std::uintptr_t>(dst) & 2)
+    {
+        *dst++ = value;
+        --count;
+    }
+
+    auto* words = reinterpret_cast<std::uint32_t*>(dst);
+    const std::uint32_t pair = value | (std::uint32_t(value) << 16);
+    const int words_count = count >> 1;
+
+    // Butano's word set, which uses DMA if `bn::memory::dma_enabled()`.
+    if (words_count > 0)
+        bn::memory::set_words(pair, words_count, words);
+
+    if (count & 1)
+        *reinterpret_cast<std::uint16_t*>(words + words_count) = value;
+}
+
+[[gnu::always_inline]] inline void copy_span(std::uint16_t* dst, const std::uint16_t* src, int count)
+{
+    // Word copy is only possible if both are aligned the same.
+    if (((reinterpret_cast<std::uintptr_t>(dst) ^ reinterpret_cast<std::uintptr_t>(src)) & 2) == 0)
+    {
+        if ((reinterpret_cast<std::uintptr_t>(dst) & 2) && count > 0)
+        {
+            *dst++ = *src++;
+            --count;
+        }
+
+        auto* dst_words = reinterpret_cast<std::uint32_t*>(dst);
+        const auto* src_words = reinterpret_cast<const std::uint32_t*>(src);
+        const int words_count = count >> 1;
+
+        // Butano's word copy, which uses DMA if `bn::memory::dma_enabled()`.
+        if (words_count > 0)
+            bn::memory::copy(*src_words, words_count, *dst_words);
+
+        if (count & 1)
+        {
+            *reinterpret_cast<std::uint16_t*>(dst_words + words_count) =
+                *reinterpret_cast<const std::uint16_t*>(src_words + words_count);
+        }
+    }
+    else
+    {
+        for (; count > 0; --count)
+            *dst++ = *src++;
+    }
+}
+
+[[gnu::always_inline]] inline void lookup_span(std::uint16_t* dst, const std::uint8_t* src,
+                                               const std::uint16_t* palette, int count)
+{
+    if (count <= 0)
+        return;
+
+    // Align to a word.
+    if (reinterpret_cast<std::uintptr_t>(dst) & 2)
+    {
+        *dst++ = palette[*src++];
+        --count;
+    }
+
+    auto* words = reinterpret_cast<std::uint32_t*>(dst);
+    int words_count = count >> 1;
+
+    // 2 words per iteration, so that the 4 indexes are loaded back to back.
+    for (; words_count >= 2; words_count -= 2, words += 2, src += 4)
+    {
+        const int i0 = src[0];
+        const int i1 = src[1];
+        const int i2 = src[2];
+        const int i3 = src[3];
+        words[0] = palette[i0] | (std::uint32_t(palette[i1]) << 16);
+        words[1] = palette[i2] | (std::uint32_t(palette[i3]) << 16);
+    }
+    if (words_count > 0)
+    {
+        *words++ = palette[src[0]] | (std::uint32_t(palette[src[1]]) << 16);
+        src += 2;
+    }
+
+    if (count & 1)
+        *reinterpret_cast<std::uint16_t*>(words) = palette[*src];
+}
+
+} // namespace
+
+BN_CODE_IWRAM void fill_rect(std::uint16_t* page, int x, int y, int width, int height, bn::color color)
+{
+    std::uint16_t* row = page + y * PAGE_STRIDE + x;
+
+    for (int row_idx = 0; row_idx < height; ++row_idx, row += PAGE_STRIDE)
+        fill_span(row, width, color.data());
+}
+
+BN_CODE_IWRAM void blit_rect(std::uint16_t* page, int x, int y, const bn::color* src, int src_stride, int width,
+                             int height)
+{
+    std::uint16_t* dst_row = page + y * PAGE_STRIDE + x;
+    const auto* src_row = reinterpret_cast<const std::uint16_t*>(src);
+
+    for (int row_idx = 0; row_idx < height; ++row_idx, dst_row += PAGE_STRIDE, src_row += src_stride)
+        copy_span(dst_row, src_row, width);
+}
+
+BN_CODE_IWRAM void blit_indexed_rect(std::uint16_t* page, int x, int y, const std::uint8_t* src, int src_stride,
+                                     const bn::color* palette, int width, int height)
+{
+    std::uint16_t* dst_row = page + y * PAGE_STRIDE + x;
+    const auto* palette_values = reinterpret_cast<const std::uint16_t*>(palette);
+
+    for (int row_idx = 0; row_idx < height; ++row_idx, dst_row += PAGE_STRIDE, src += src_stride)
+        lookup_span(dst_row, src, palette_values, width);
+}
+
+BN_CODE_IWRAM void draw_frame(std::uint16_t* page, int x, int y, int width, int height, bn::color outer,
+                              bn::color inner)
+{
+    BN_ASSERT(width >= 4 && height >= 4, "Too small frame: ", width, "x", height);
+    BN_ASSERT(x % 2 == 0 && width % 2 == 0, "Unaligned frame: ", x, ", ", width);
+
+    const std::uint16_t outer_value = outer.data();
+    const std::uint16_t inner_value = inner.data();
+
+    std::uint16_t* row = page + y * PAGE_STRIDE + x;
+
+    // Top
+    fill_span(row, width, outer_value);
+    row += PAGE_STRIDE;
+    row[0] = outer_value;
+    fill_span(row + 1, width - 2, inner_value);
+    row[width - 1] = outer_value;
+    row += PAGE_STRIDE;
+
+    // Left & right, little endian pairs of (outer, inner) and (inner, outer)
+    const std::uint32_t left_pair = outer_value | (std::uint32_t(inner_value) << 16);
+    const std::uint32_t right_pair = inner_value | (std::uint32_t(outer_value) << 16);
+    for (int row_idx = 2; row_idx < height - 2; ++row_idx, row += PAGE_STRIDE)
+    {
+        *reinterpret_cast<std::uint32_t*>(row) = left_pair;
+        *reinterpret_cast<std::uint32_t*>(row + width - 2) = right_pair;
+    }
+
+    // Bottom
+    row[0] = outer_value;
+    fill_span(row + 1, width - 2, inner_value);
+    row[width - 1] = outer_value;
+    row += PAGE_STRIDE;
+    fill_span(row, width, outer_value);
+}
+
+} // namespace jb::sys::bitmap_kernels
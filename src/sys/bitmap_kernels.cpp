@@ -0,0 +1,13 @@
+#include "sys/bitmap_kernels.h"
+
+#include <bn_dp_direct_bitmap_bg_painter.h>
+
+namespace jb::sys::bitmap_kernels
+{
+
+auto dp_back_page(bn::dp_direct_bitmap_bg_painter& painter) -> std::uint16_t*
+{
+    return reinterpret_cast<std::uint16_t*>(painter.page().data());
+}
+
+} // namespace jb::sys::bitmap_kernels
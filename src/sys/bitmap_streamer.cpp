@@ -0,0 +1,288 @@
+#include "sys/bitmap_streamer.h"
+
+#include <bn_assert.h>
+#include <bn_compression_type.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+
+namespace jb::sys
+{
+
+namespace
+{
+
+constexpr int HEADER_BYTES = 4;
+
+auto read_u32(const std::uint8_t* src) -> std::uint32_t
+{
+    return src[0] | (src[1] << 8) | (src[2] << 16) | (static_cast<std::uint32_t>(src[3]) << 24);
+}
+
+} // namespace
+
+bitmap_streamer::bitmap_streamer(const bn::direct_bitmap_item& item, bn::span<std::uint8_t> buffer)
+    : bitmap_streamer(reinterpret_cast<const std::uint8_t*>(item.colors_ref().data()), item.dimensions(),
+                      int(sizeof(bn::color)), item.compression(), buffer)
+{
+}
+
+bitmap_streamer::bitmap_streamer(const indexed_bitmap_item& item, bn::span<std::uint8_t> buffer)
+    : bitmap_streamer(item.indexes_ref().data(), item.dimensions(), 1, item.compression(), buffer)
+{
+    _palette = item.palette_ref();
+}
+
+bitmap_streamer::bitmap_streamer(const std::uint8_t* src, const bn::size& dimensions, int pixel_bytes,
+                                 bn::compression_type compression, bn::span<std::uint8_t> buffer)
+    : _dimensions(dimensions), _compression(compression), _pixel_bytes(std::uint8_t(pixel_bytes)), _buffer(buffer),
+      _src(src), _total_bytes(dimensions.width() * dimensions.height() * pixel_bytes), _decoded_bytes(0),
+      _write_pos(0), _emit_pos(0), _streamed_rows(0), _lz77_flags(0), _lz77_flags_left(0), _huffman_root(nullptr),
+      _huffman_word(0), _huffman_bits_left(0), _huffman_symbol_bits(0)
+{
+    BN_ASSERT(dimensions.width() * pixel_bytes <= STRIP_BYTES, "Too wide bitmap: ", dimensions.width());
+
+    if (compression == bn::compression_type::NONE)
+        return;
+
+    BN_ASSERT(buffer.size() >= BUFFER_BYTES, "Too small buffer: ", buffer.size(), " (min ", BUFFER_BYTES, ")");
+    BN_ASSERT(reinterpret_cast<std::uintptr_t>(buffer.data()) % alignof(bn::color) == 0, "Unaligned buffer");
+
+    // Header: compression type in the low byte, and the decompressed size in the upper 24 bits.
+    const std::uint32_t header = read_u32(_src);
+    BN_ASSERT(int(header >> 8) >= _total_bytes, "Invalid decompressed size: ", int(header >> 8));
+    _src += HEADER_BYTES;
+
+    if (compression == bn::compression_type::HUFFMAN)
+    {
+        _huffman_symbol_bits = header & 0xF;
+        BN_ASSERT(_huffman_symbol_bits == 4 || _huffman_symbol_bits == 8,
+                  "Invalid Huffman symbol bits: ", (int)_huffman_symbol_bits);
+
+        // Tree size byte, and the root node right after it.
+        const int tree_bytes = (_src[0] + 1) * 2;
+        _huffman_root = _src + 1;
+        _src += tree_bytes;
+    }
+}
+
+auto bitmap_streamer::dimensions() const -> bn::size
+{
+    return _dimensions;
+}
+
+int bitmap_streamer::streamed_rows() const
+{
+    return _streamed_rows;
+}
+
+bool bitmap_streamer::done() const
+{
+    return _streamed_rows >= dimensions().height();
+}
+
+bool bitmap_streamer::indexed() const
+{
+    return _pixel_bytes == 1;
+}
+
+auto bitmap_streamer::next_strip() -> bn::direct_bitmap_item
+{
+    return next_strip(dimensions().height());
+}
+
+auto bitmap_streamer::next_strip(int max_rows) -> bn::direct_bitmap_item
+{
+    BN_ASSERT(!indexed(), "Not a direct bitmap");
+
+    int rows;
+    const auto* colors = reinterpret_cast<const bn::color*>(next_strip_bytes(max_rows, rows));
+    const int width = dimensions().width();
+
+    return bn::direct_bitmap_item(bn::span<const bn::color>(colors, rows * width), bn::size(width, rows));
+}
+
+auto bitmap_streamer::next_indexed_strip(int max_rows) -> indexed_bitmap_item
+{
+    BN_ASSERT(indexed(), "Not an indexed bitmap");
+
+    int rows;
+    const std::uint8_t* indexes = next_strip_bytes(max_rows, rows);
+    const int width = dimensions().width();
+
+    return indexed_bitmap_item(bn::span<const std::uint8_t>(indexes, rows * width), _palette, bn::size(width, rows),
+                               bn::compression_type::NONE);
+}
+
+auto bitmap_streamer::next_strip_bytes(int max_rows, int& rows) -> const std::uint8_t*
+{
+    BN_ASSERT(!done(), "Bitmap is already streamed");
+    BN_ASSERT(max_rows > 0, "Invalid max rows: ", max_rows);
+
+    const int row_bytes = dimensions().width() * _pixel_bytes;
+    rows = std::min({STRIP_BYTES / row_bytes, max_rows, dimensions().height() - _streamed_rows});
+    const int strip_bytes = rows * row_bytes;
+
+    if (_compression == bn::compression_type::NONE)
+    {
+        const std::uint8_t* bytes = _src + _streamed_rows * row_bytes;
+        _streamed_rows += rows;
+        return bytes;
+    }
+
+    compact();
+
+    decode_until(_emit_pos + strip_bytes);
+    BN_ASSERT(_write_pos >= _emit_pos + strip_bytes, "Compressed data ended early");
+
+    const std::uint8_t* bytes = _buffer.data() + _emit_pos;
+    _emit_pos += strip_bytes;
+    _streamed_rows += rows;
+
+    return bytes;
+}
+
+void bitmap_streamer::compact()
+{
+    // Keep the window behind the not emitted data, so that LZ77 can still refer to it.
+    const int keep_pos = std::max(_emit_pos - WINDOW_BYTES, 0);
+    if (keep_pos == 0)
+        return;
+
+    std::memmove(_buffer.data(), _buffer.data() + keep_pos, _write_pos - keep_pos);
+    _write_pos -= keep_pos;
+    _emit_pos -= keep_pos;
+}
+
+void bitmap_streamer::decode_until(int write_pos)
+{
+    while (_write_pos < write_pos && _decoded_bytes < _total_bytes)
+    {
+        switch (_compression)
+        {
+        case bn::compression_type::LZ77:
+            decode_lz77_token();
+            break;
+
+        case bn::compression_type::RUN_LENGTH:
+            decode_run_length_token();
+            break;
+
+        case bn::compression_type::HUFFMAN:
+            decode_huffman_token();
+            break;
+
+        default:
+            BN_ERROR("Invalid compression: ", (int)_compression);
+        }
+    }
+
+    BN_ASSERT(_write_pos <= _buffer.size(), "Buffer overflow: ", _write_pos);
+}
+
+void bitmap_streamer::decode_lz77_token()
+{
+    if (_lz77_flags_left == 0)
+    {
+        _lz77_flags = *_src++;
+        _lz77_flags_left = 8;
+    }
+
+    const bool compressed = _lz77_flags & 0x80;
+    _lz77_flags <<= 1;
+    --_lz77_flags_left;
+
+    if (!compressed)
+    {
+        put_byte(*_src++);
+    }
+    else
+    {
+        const int b0 = *_src++;
+        const int b1 = *_src++;
+        const int length = (b0 >> 4) + 3;
+        const int displacement = (((b0 & 0xF) << 8) | b1) + 1;
+
+        for (int i = 0; i < length; ++i)
+            put_byte(_buffer[_write_pos - displacement]);
+    }
+}
+
+void bitmap_streamer::decode_run_length_token()
+{
+    const int flag = *_src++;
+
+    if (flag & 0x80)
+    {
+        const int length = (flag & 0x7F) + 3;
+        const std::uint8_t byte = *_src++;
+
+        for (int i = 0; i < length; ++i)
+            put_byte(byte);
+    }
+    else
+    {
+        const int length = (flag & 0x7F) + 1;
+
+        for (int i = 0; i < length; ++i)
+            put_byte(*_src++);
+    }
+}
+
+void bitmap_streamer::decode_huffman_token()
+{
+    if (_huffman_symbol_bits == 8)
+    {
+        put_byte(decode_huffman_symbol());
+    }
+    else
+    {
+        // Lower nibble comes first.
+        const std::uint8_t low = decode_huffman_symbol();
+        const std::uint8_t high = decode_huffman_symbol();
+        put_byte(low | (high << 4));
+    }
+}
+
+auto bitmap_streamer::decode_huffman_symbol() -> std::uint8_t
+{
+    const std::uint8_t* node = _huffman_root;
+
+    while (true)
+    {
+        if (_huffman_bits_left == 0)
+        {
+            _huffman_word = read_u32(_src);
+            _src += 4;
+            _huffman_bits_left = 32;
+        }
+
+        const bool bit = _huffman_word & 0x80000000;
+        _huffman_word <<= 1;
+        --_huffman_bits_left;
+
+        // Children are next to each other, at the offset from the aligned node address.
+        const std::uint8_t node_value = *node;
+        const auto children_addr = (reinterpret_cast<std::uintptr_t>(node) & ~std::uintptr_t(1)) +
+                                   (node_value & 0x3F) * 2 + 2;
+        const auto* child = reinterpret_cast<const std::uint8_t*>(children_addr) + bit;
+        const bool child_is_data = bit ? (node_value & 0x40) : (node_value & 0x80);
+
+        if (child_is_data)
+            return *child;
+
+        node = child;
+    }
+}
+
+void bitmap_streamer::put_byte(std::uint8_t byte)
+{
+    if (_decoded_bytes >= _total_bytes)
+        return;
+
+    _buffer[_write_pos++] = byte;
+    ++_decoded_bytes;
+}
+
+} // namespace jb::sys
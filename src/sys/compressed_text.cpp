@@ -0,0 +1,52 @@
+#include "sys/compressed_text.h"
+
+#include <bn_assert.h>
+
+namespace jb::sys
+{
+
+int compressed_text::decompress_block(int block_idx, bn::span<char> output) const
+{
+    BN_ASSERT(block_idx >= 0 && block_idx < blocks_count(), "Invalid block idx: ", block_idx);
+    BN_ASSERT(output.size() >= MAX_BLOCK_BYTES, "Too small output: ", output.size());
+
+    const std::uint8_t* src = _data_ref.data() + (block_idx == 0 ? 0 : _block_ends_ref[block_idx - 1]);
+    const std::uint8_t* const src_end = _data_ref.data() + _block_ends_ref[block_idx];
+    const std::uint8_t* const dictionary_end = _dictionary_ref.data() + _dictionary_ref.size();
+    char* dst = output.data();
+
+    while (src < src_end)
+    {
+        const int token = *src++;
+
+        if (token & 0x80)
+        {
+            const int length = (token & 0x7F) + MIN_MATCH_LENGTH;
+            const int distance = (src[0] | (src[1] << 8)) + 1;
+            src += 2;
+
+            BN_ASSERT((dst - output.data()) + length <= MAX_BLOCK_BYTES, "Block overflow");
+            BN_ASSERT(distance <= (dst - output.data()) + _dictionary_ref.size(), "Invalid distance: ", distance);
+
+            for (int i = 0; i < length; ++i, ++dst)
+            {
+                // Bytes before the block are the end of the dictionary.
+                const int back = int(dst - output.data()) - distance;
+                *dst = back >= 0 ? output[back] : char(dictionary_end[back]);
+            }
+        }
+        else
+        {
+            const int length = token + 1;
+
+            BN_ASSERT((dst - output.data()) + length <= MAX_BLOCK_BYTES, "Block overflow");
+
+            for (int i = 0; i < length; ++i)
+                *dst++ = char(*src++);
+        }
+    }
+
+    return int(dst - output.data());
+}
+
+} // namespace jb::sys
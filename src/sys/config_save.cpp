@@ -1,7 +1,11 @@
 #include "sys/config_save.h"
 
+#include "dev/dev_counters.h"
+
 #include "ibn_sram_rw.h"
 
+#include <bn_assert.h>
+
 #include <type_traits>
 
 namespace jb::sys
@@ -17,9 +21,21 @@ constexpr unsigned SAVE_LOCATION_1 = bn::sram::size() - 256;
 
 constexpr std::uint32_t FOOTER = 0x5A7EF001; // SAVE FOOT
 
+// Bytes written by `write()`, only used for the dev counters.
+constexpr int SAVE_DATA_BYTES = (32 + 8 + 16 + 32) / 8;
+
+constexpr int PLAYLIST_REPEAT_BITS = 2;
+constexpr std::uint8_t PLAYLIST_REPEAT_MASK = (1 << PLAYLIST_REPEAT_BITS) - 1;
+constexpr std::uint8_t PLAYLIST_SHUFFLE_FLAG = 1 << PLAYLIST_REPEAT_BITS;
+
+static_assert((int)repeat_mode::MAX_COUNT <= PLAYLIST_REPEAT_MASK + 1);
+
+constexpr unsigned FRAMES_PER_MINUTE = 60 * 60;
+
 } // namespace
 
 config_save::config_save()
+    : _dirty(false), _frame(0), _changed_frame(0), _write_frames{}, _write_frames_head(0), _write_frames_count(0)
 {
     reset();
 }
@@ -27,6 +43,9 @@ config_save::config_save()
 void config_save::reset()
 {
     _tune_index = 0;
+    _repeat = repeat_mode::ONE;
+    _shuffle = false;
+    _shuffle_seed = 1;
 }
 
 bool config_save::load()
@@ -47,6 +66,41 @@ void config_save::save()
 {
     ibn::sram_rw rw(SAVE_MAGIC, SAVE_LOCATION_0, SAVE_LOCATION_1);
     rw.write(*this);
+
+    _dirty = false;
+
+    // Record the write frame, overwriting the oldest one if full.
+    _write_frames[_write_frames_head] = _frame;
+    _write_frames_head = (_write_frames_head + 1) % MAX_WRITES_PER_MINUTE;
+    if (_write_frames_count < MAX_WRITES_PER_MINUTE)
+        ++_write_frames_count;
+
+    if constexpr (JB_DEVBUILD)
+    {
+        dev::add_counter(dev::counter::SRAM_WRITES);
+        dev::log_counter(dev::counter::SRAM_WRITES);
+        dev::log_counter(dev::counter::SRAM_SKIPPED_WRITES);
+        dev::log_counter(dev::counter::SRAM_SKIPPED_BYTES);
+    }
+}
+
+void config_save::update()
+{
+    ++_frame;
+
+    if (_dirty && _frame - _changed_frame >= static_cast<unsigned>(IDLE_FLUSH_FRAMES))
+        flush();
+}
+
+void config_save::flush()
+{
+    if (_dirty && write_allowed())
+        save();
+}
+
+bool config_save::dirty() const
+{
+    return _dirty;
 }
 
 unsigned config_save::tune_index() const
@@ -56,32 +110,125 @@ unsigned config_save::tune_index() const
 
 void config_save::set_tune_index(unsigned index)
 {
+    const bool changed = (index != _tune_index);
     _tune_index = index;
+
+    mark_dirty(changed);
+}
+
+auto config_save::repeat() const -> repeat_mode
+{
+    return _repeat;
+}
+
+void config_save::set_repeat(repeat_mode repeat)
+{
+    BN_ASSERT(repeat < repeat_mode::MAX_COUNT, "Invalid repeat mode: ", (int)repeat);
+
+    const bool changed = (repeat != _repeat);
+    _repeat = repeat;
+
+    mark_dirty(changed);
+}
+
+bool config_save::shuffle() const
+{
+    return _shuffle;
+}
+
+void config_save::set_shuffle(bool shuffle)
+{
+    const bool changed = (shuffle != _shuffle);
+    _shuffle = shuffle;
+
+    mark_dirty(changed);
+}
+
+auto config_save::shuffle_seed() const -> std::uint16_t
+{
+    return _shuffle_seed;
+}
+
+void config_save::set_shuffle_seed(std::uint16_t seed)
+{
+    const bool changed = (seed != _shuffle_seed);
+    _shuffle_seed = seed;
+
+    mark_dirty(changed);
+}
+
+auto config_save::playlist_flags() const -> std::uint8_t
+{
+    return static_cast<std::uint8_t>((std::uint8_t)_repeat | (_shuffle ? PLAYLIST_SHUFFLE_FLAG : 0));
+}
+
+void config_save::set_playlist_flags(std::uint8_t flags)
+{
+    _repeat = static_cast<repeat_mode>(flags & PLAYLIST_REPEAT_MASK);
+    _shuffle = (flags & PLAYLIST_SHUFFLE_FLAG);
+}
+
+void config_save::mark_dirty(bool changed)
+{
+    // Every set used to be an SRAM write, so count the ones that won't be written on their own:
+    // either nothing changed, or it overwrites a change that wasn't flushed yet.
+    if constexpr (JB_DEVBUILD)
+    {
+        if (!changed || _dirty)
+        {
+            dev::add_counter(dev::counter::SRAM_SKIPPED_WRITES);
+            dev::add_counter(dev::counter::SRAM_SKIPPED_BYTES, SAVE_DATA_BYTES);
+        }
+    }
+
+    if (changed)
+    {
+        _dirty = true;
+        _changed_frame = _frame;
+    }
+}
+
+bool config_save::write_allowed() const
+{
+    if (_write_frames_count < MAX_WRITES_PER_MINUTE)
+        return true;
+
+    // When full, head points to the oldest write.
+    return _frame - _write_frames[_write_frames_head] >= FRAMES_PER_MINUTE;
 }
 
 void config_save::measure(ibn::bit_stream_measurer& measurer) const
 {
     measurer
-        .write(_tune_index) // 32 bits
-        .write(FOOTER);     // footer: 32 bits
+        .write(_tune_index)      // 32 bits
+        .write(playlist_flags()) // 8 bits
+        .write(_shuffle_seed)    // 16 bits
+        .write(FOOTER);          // footer: 32 bits
 }
 
 void config_save::write(ibn::bit_stream_writer& writer) const
 {
     writer
-        .write(_tune_index) // 32 bits
-        .write(FOOTER);     // footer: 32 bits
+        .write(_tune_index)      // 32 bits
+        .write(playlist_flags()) // 8 bits
+        .write(_shuffle_seed)    // 16 bits
+        .write(FOOTER);          // footer: 32 bits
 }
 
 void config_save::read(ibn::bit_stream_reader& reader)
 {
+    std::uint8_t playlist_flags = 0;
     std::uint32_t footer = 0;
 
     reader
-        .read(_tune_index) // 32 bits
-        .read(footer);     // footer: 32 bits
+        .read(_tune_index)    // 32 bits
+        .read(playlist_flags) // 8 bits
+        .read(_shuffle_seed)  // 16 bits
+        .read(footer);        // footer: 32 bits
+
+    set_playlist_flags(playlist_flags);
 
-    if (footer != FOOTER)
+    if (footer != FOOTER || _repeat >= repeat_mode::MAX_COUNT)
         reader.set_fail();
 }
 
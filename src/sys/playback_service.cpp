@@ -0,0 +1,168 @@
+#include "sys/playback_service.h"
+
+#include "sys/tune_metadata.h"
+
+#include <bn_dmg_music.h>
+#include <bn_dmg_music_item.h>
+
+#include <algorithm>
+
+namespace jb::sys
+{
+
+void playback_service::play(const bn::dmg_music_item& item, const tune_metadata& metadata, bn::fixed volume, bool loop,
+                            int track_id)
+{
+    _next.reset();
+    item.play(volume, loop);
+
+    _playing = true;
+    _loop = loop;
+    _last_pattern = 0;
+    _track_id = track_id;
+    _elapsed_ticks = 0;
+    _total_ticks = metadata.total_ticks();
+    raise(playback_event::STARTED);
+}
+
+void playback_service::stop()
+{
+    if (!_playing)
+        return;
+
+    bn::dmg_music::stop();
+
+    _playing = false;
+    _next.reset();
+    raise(playback_event::STOPPED);
+}
+
+void playback_service::pause()
+{
+    if (!_playing || bn::dmg_music::paused())
+        return;
+
+    bn::dmg_music::pause();
+    raise(playback_event::PAUSED);
+}
+
+void playback_service::resume()
+{
+    if (!_playing || !bn::dmg_music::paused())
+        return;
+
+    bn::dmg_music::resume();
+    raise(playback_event::RESUMED);
+}
+
+bool playback_service::playing() const
+{
+    return _playing;
+}
+
+bool playback_service::paused() const
+{
+    return _playing && bn::dmg_music::paused();
+}
+
+int playback_service::track_id() const
+{
+    return _track_id;
+}
+
+int playback_service::elapsed_ticks() const
+{
+    return _elapsed_ticks;
+}
+
+void playback_service::seek(const tune_metadata& metadata, int ticks)
+{
+    if (!_playing)
+        return;
+
+    const tune_metadata::seek_point target = metadata.seek_target(std::clamp(ticks, 0, metadata.total_ticks() - 1));
+    bn::dmg_music::set_position(target.order, target.row);
+
+    // Seeking backward isn't the loop point.
+    _last_pattern = target.order;
+    _elapsed_ticks = target.ticks;
+}
+
+void playback_service::prepare_next(const bn::dmg_music_item& item, const tune_metadata& metadata, bn::fixed volume,
+                                    bool loop, int track_id)
+{
+    _next = track{&item, &metadata, volume, loop, track_id};
+}
+
+void playback_service::clear_next()
+{
+    _next.reset();
+}
+
+void playback_service::subscribe(observer_t& observer)
+{
+    observer.subscribe(_subject);
+}
+
+void playback_service::update()
+{
+    if (_playing)
+    {
+        if (!bn::dmg_music::playing())
+        {
+            end_track();
+        }
+        else
+        {
+            if (!bn::dmg_music::paused())
+                ++_elapsed_ticks;
+
+            if (_loop)
+            {
+                // Pattern only goes backward when it jumps to the loop point.
+                const int pattern = bn::dmg_music::position().pattern();
+                if (pattern < _last_pattern)
+                    raise(playback_event::LOOP_POINT);
+                _last_pattern = pattern;
+            }
+            else if (_next.has_value() && _elapsed_ticks >= _total_ticks)
+            {
+                // Every tick is played, so the next track doesn't wait for the engine to stop.
+                end_track();
+            }
+        }
+    }
+
+    // Observers might raise events of their own, which are dispatched on the next frame.
+    const bn::vector<playback_event, MAX_PENDING_EVENTS> events = _pending_events;
+    _pending_events.clear();
+
+    for (const playback_event event : events)
+        _subject.notify(event);
+}
+
+void playback_service::end_track()
+{
+    _playing = false;
+    raise(playback_event::END_OF_TRACK);
+
+    // Started right away, before the observers are notified.
+    if (_next.has_value())
+    {
+        const track next = *_next;
+        _next.reset();
+        play(*next.item, *next.metadata, next.volume, next.loop, next.track_id);
+    }
+}
+
+void playback_service::raise(playback_event event)
+{
+    // Merged into the pending one, e.g. when it's paused, resumed and paused again in the same frame.
+    auto pending = std::find(_pending_events.begin(), _pending_events.end(), event);
+    if (pending != _pending_events.end())
+        _pending_events.erase(pending);
+
+    _pending_events.push_back(event);
+}
+
+} // namespace jb::sys
@@ -0,0 +1,183 @@
+#include "sys/playlist.h"
+
+#include "sys/config_save.h"
+#include "tune_info.h"
+
+#include <bn_assert.h>
+
+#include <utility>
+
+namespace jb::sys
+{
+
+namespace
+{
+
+/// xorshift16, kept here so that a saved seed always gives back the same queue.
+auto next_random(std::uint16_t& state) -> std::uint16_t
+{
+    state ^= state << 7;
+    state ^= state >> 9;
+    state ^= state << 8;
+    return state;
+}
+
+} // namespace
+
+playlist::playlist(playback_service& playback, config_save& config_save_)
+    : _playback(playback), _config_save(config_save_),
+      _playback_observer([this](playback_event event) { on_playback_event(event); })
+{
+    _playback.subscribe(_playback_observer);
+}
+
+void playlist::play(int tune_index)
+{
+    const tune_info& info = tune_info::tunes_list()[tune_index];
+
+    // Queue is synced and the next tune is prepared on `playback_event::STARTED`.
+    _playback.play(info.tune(), info.metadata(), 1, loops(tune_index), tune_index);
+}
+
+void playlist::on_playback_event(playback_event event)
+{
+    switch (event)
+    {
+    case playback_event::STARTED:
+        sync_queue();
+        break;
+
+    case playback_event::LOOP_POINT:
+        // Started with `repeat_mode::ONE`, and the repeat mode is changed since.
+        if (repeat() != repeat_mode::ONE)
+        {
+            if (const bn::optional<int> next = next_position())
+                play(_queue[*next]);
+            else
+                _playback.stop();
+        }
+        break;
+
+    default:
+        break;
+    }
+}
+
+auto playlist::repeat() const -> repeat_mode
+{
+    return _config_save.repeat();
+}
+
+void playlist::set_repeat(repeat_mode repeat)
+{
+    _config_save.set_repeat(repeat);
+
+    if (_playback.playing())
+        sync_queue();
+}
+
+bool playlist::shuffle() const
+{
+    return _config_save.shuffle();
+}
+
+void playlist::set_shuffle(bool shuffle)
+{
+    if (shuffle && !_config_save.shuffle())
+    {
+        std::uint16_t seed = _config_save.shuffle_seed();
+        _config_save.set_shuffle_seed(next_random(seed));
+    }
+    _config_save.set_shuffle(shuffle);
+
+    rebuild_queue();
+
+    if (_playback.playing())
+        sync_queue();
+}
+
+void playlist::sync_queue()
+{
+    // Built lazily, as the config is loaded after the construction.
+    if (_queue.empty())
+        rebuild_queue();
+
+    _position = queue_position(_playback.track_id());
+    prepare_next();
+}
+
+void playlist::rebuild_queue()
+{
+    const int tunes_count = tune_info::tunes_list().size();
+    BN_ASSERT(tunes_count <= MAX_TUNES, "Too many tunes: ", tunes_count);
+
+    _queue.clear();
+    for (int idx = 0; idx < tunes_count; ++idx)
+        _queue.push_back(static_cast<std::uint8_t>(idx));
+
+    if (_config_save.shuffle())
+    {
+        // Fisher-Yates, with the saved seed
+        std::uint16_t state = _config_save.shuffle_seed();
+        if (state == 0)
+            state = 1;
+
+        for (int idx = tunes_count - 1; idx > 0; --idx)
+            std::swap(_queue[idx], _queue[next_random(state) % (idx + 1)]);
+    }
+}
+
+void playlist::prepare_next()
+{
+    const bn::optional<int> next = next_position();
+    if (!next.has_value())
+    {
+        _playback.clear_next();
+        return;
+    }
+
+    const int tune_index = _queue[*next];
+    const tune_info& info = tune_info::tunes_list()[tune_index];
+    _playback.prepare_next(info.tune(), info.metadata(), 1, loops(tune_index), tune_index);
+}
+
+auto playlist::next_position() const -> bn::optional<int>
+{
+    switch (repeat())
+    {
+    case repeat_mode::ONE:
+        return _position;
+
+    case repeat_mode::ALL:
+        return (_position + 1) % _queue.size();
+
+    case repeat_mode::OFF:
+        if (_position + 1 >= _queue.size())
+            return bn::nullopt;
+        return _position + 1;
+
+    default:
+        BN_ERROR("Invalid repeat mode: ", (int)repeat());
+    }
+
+    return bn::nullopt;
+}
+
+bool playlist::loops(int tune_index) const
+{
+    return repeat() == repeat_mode::ONE && tune_info::tunes_list()[tune_index].loop();
+}
+
+auto playlist::queue_position(int tune_index) const -> int
+{
+    for (int position = 0; position < _queue.size(); ++position)
+    {
+        if (_queue[position] == tune_index)
+            return position;
+    }
+
+    BN_ERROR("Tune not in queue: ", tune_index);
+    return 0;
+}
+
+} // namespace jb::sys
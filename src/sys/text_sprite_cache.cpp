@@ -0,0 +1,96 @@
+#include "sys/text_sprite_cache.h"
+
+#include "dev/dev_counters.h"
+
+#include <bn_assert.h>
+#include <bn_sprite_palette_item.h>
+#include <bn_sprite_palette_ptr.h>
+
+#include <algorithm>
+
+namespace jb::sys
+{
+
+bool text_sprite_cache::create_top_left(text_generators::font font, const bn::string_view& text,
+                                        const bn::fixed_point& top_left_position,
+                                        const bn::sprite_palette_item& palette_item,
+                                        bn::ivector<bn::sprite_ptr>& output_sprites)
+{
+    entry* found = find(font, text);
+
+    if (!found || output_sprites.available() < found->sprites.size())
+    {
+        if constexpr (JB_DEVBUILD)
+            dev::add_counter(dev::counter::TEXT_CACHE_MISSES);
+
+        return false;
+    }
+
+    if constexpr (JB_DEVBUILD)
+        dev::add_counter(dev::counter::TEXT_CACHE_HITS);
+
+    found->last_used = ++_tick;
+
+    const bn::sprite_palette_ptr palette = palette_item.create_palette();
+    for (const cached_sprite& cached : found->sprites)
+        output_sprites.push_back(
+            bn::sprite_ptr::create(top_left_position + cached.offset, cached.shape_size, cached.tiles, palette));
+
+    return true;
+}
+
+void text_sprite_cache::store(text_generators::font font, const bn::string_view& text,
+                              const bn::fixed_point& top_left_position, bn::span<const bn::sprite_ptr> text_sprites)
+{
+    if (text_sprites.empty() || text_sprites.size() > MAX_SPRITES_PER_ENTRY || find(font, text))
+        return;
+
+    int tiles_count = 0;
+    for (const bn::sprite_ptr& spr : text_sprites)
+        tiles_count += spr.tiles().tiles_count();
+
+    if (tiles_count > MAX_TILES)
+        return;
+
+    while (_entries.full() || _tiles_count + tiles_count > MAX_TILES)
+        evict_least_recently_used();
+
+    entry& new_entry = _entries.emplace_back(font, text, ++_tick, tiles_count);
+    for (const bn::sprite_ptr& spr : text_sprites)
+        new_entry.sprites.push_back(cached_sprite{spr.tiles(), spr.shape_size(), spr.position() - top_left_position});
+
+    _tiles_count += tiles_count;
+}
+
+void text_sprite_cache::clear()
+{
+    _entries.clear();
+    _tiles_count = 0;
+}
+
+int text_sprite_cache::tiles_count() const
+{
+    return _tiles_count;
+}
+
+auto text_sprite_cache::find(text_generators::font font, const bn::string_view& text) -> entry*
+{
+    auto iter = std::ranges::find_if(_entries, [&](const entry& e) { return e.font == font && e.text == text; });
+
+    return iter != _entries.end() ? &*iter : nullptr;
+}
+
+void text_sprite_cache::evict_least_recently_used()
+{
+    BN_ASSERT(!_entries.empty(), "Nothing to evict");
+
+    auto lru = std::ranges::min_element(_entries, [this](const entry& l, const entry& r) {
+        // Compare the age, so that it works even if `_tick` wraps around.
+        return _tick - l.last_used > _tick - r.last_used;
+    });
+
+    _tiles_count -= lru->tiles_count;
+    _entries.erase(lru);
+}
+
+} // namespace jb::sys
@@ -0,0 +1,166 @@
+#include "sys/thumbnail_cache.h"
+
+#include <bn_assert.h>
+#include <bn_compression_type.h>
+#include <bn_timer.h>
+
+#include <algorithm>
+
+namespace jb::sys
+{
+
+thumbnail_cache::thumbnail_cache() : _prefetching_slot(nullptr)
+{
+    clear();
+}
+
+auto thumbnail_cache::find(const thumbnail_item& item) const -> bn::optional<thumbnail_item>
+{
+    const slot* found = find_slot(item);
+    if (!found || !found->complete)
+        return bn::nullopt;
+
+    const int pixels_count = found->dimensions.width() * found->dimensions.height();
+    return thumbnail_item(indexed_bitmap_item(bn::span<const std::uint8_t>(found->indexes.data(), pixels_count),
+                                              found->palette, found->dimensions, bn::compression_type::NONE));
+}
+
+void thumbnail_cache::reserve_prefetches(bn::span<const thumbnail_item* const> items)
+{
+    _reserved_items.clear();
+    for (const thumbnail_item* item : items)
+        if (item && item->format() == thumbnail_item::format::INDEXED &&
+            std::ranges::find(_reserved_items, item) == _reserved_items.end() && !_reserved_items.full())
+            _reserved_items.push_back(item);
+
+    // Keep on prefetching only if it's still reserved.
+    if (_prefetching_slot && std::ranges::find(_reserved_items, _prefetching_slot->item) == _reserved_items.end())
+        cancel_prefetch();
+}
+
+bool thumbnail_cache::update_prefetch(bn::span<std::uint8_t> stream_buffer, int budget_ticks)
+{
+    // Another step is done only if the remaining budget fits one as long as the last one.
+    bn::timer timer;
+    bool done;
+    int step_ticks;
+
+    do
+    {
+        const int step_start_ticks = timer.elapsed_ticks();
+        done = step_prefetch(stream_buffer);
+        step_ticks = timer.elapsed_ticks() - step_start_ticks;
+    } while (!done && timer.elapsed_ticks() + step_ticks <= budget_ticks);
+
+    return done;
+}
+
+void thumbnail_cache::cancel_prefetch()
+{
+    if (_prefetching_slot)
+    {
+        _prefetching_slot->item = nullptr;
+        _prefetching_slot = nullptr;
+    }
+
+    _streamer.reset();
+}
+
+void thumbnail_cache::clear()
+{
+    cancel_prefetch();
+
+    for (slot& s : _slots)
+    {
+        s.item = nullptr;
+        s.complete = false;
+    }
+
+    _reserved_items.clear();
+}
+
+auto thumbnail_cache::find_slot(const thumbnail_item& item) -> slot*
+{
+    auto iter = std::ranges::find_if(_slots, [&item](const slot& s) { return s.item == &item; });
+    return iter != _slots.end() ? &*iter : nullptr;
+}
+
+auto thumbnail_cache::find_slot(const thumbnail_item& item) const -> const slot*
+{
+    auto iter = std::ranges::find_if(_slots, [&item](const slot& s) { return s.item == &item; });
+    return iter != _slots.end() ? &*iter : nullptr;
+}
+
+auto thumbnail_cache::acquire_slot() -> slot&
+{
+    // Reuse an empty slot, or the slot of a thumbnail not reserved anymore.
+    auto iter = std::ranges::find_if(_slots, [this](const slot& s) {
+        return !s.item || std::ranges::find(_reserved_items, s.item) == _reserved_items.end();
+    });
+    BN_ASSERT(iter != _slots.end(), "No slot to reuse");
+
+    return *iter;
+}
+
+void thumbnail_cache::start_prefetch(slot& s, const thumbnail_item& item, bn::span<std::uint8_t> stream_buffer)
+{
+    _streamer.emplace(item.indexed_item(), stream_buffer);
+
+    s.item = &item;
+    s.complete = false;
+    s.palette = item.palette_ref();
+    s.dimensions = bn::size(std::min(MAX_SIZE, item.dimensions().width()),
+                            std::min(MAX_SIZE, item.dimensions().height()));
+
+    _prefetching_slot = &s;
+}
+
+bool thumbnail_cache::step_prefetch(bn::span<std::uint8_t> stream_buffer)
+{
+    if (!_prefetching_slot)
+    {
+        // Start prefetching the first reserved thumbnail not cached yet.
+        auto iter = std::ranges::find_if(_reserved_items, [this](const thumbnail_item* item) {
+            const slot* found = find_slot(*item);
+            return !found || !found->complete;
+        });
+        if (iter == _reserved_items.end())
+            return true;
+
+        slot* found = find_slot(**iter);
+        start_prefetch(found ? *found : acquire_slot(), **iter, stream_buffer);
+    }
+
+    // Copy the rows of the strip in the center crop.
+    slot& prefetching = *_prefetching_slot;
+    const int crop_x = (_streamer->dimensions().width() - prefetching.dimensions.width()) / 2;
+    const int crop_y = (_streamer->dimensions().height() - prefetching.dimensions.height()) / 2;
+    const int crop_width = prefetching.dimensions.width();
+    const int crop_height = prefetching.dimensions.height();
+
+    const int strip_y = _streamer->streamed_rows();
+    const int max_rows = std::max(1, PREFETCH_STEP_BYTES / _streamer->dimensions().width());
+    const indexed_bitmap_item strip = _streamer->next_indexed_strip(max_rows);
+    const int strip_width = strip.dimensions().width();
+
+    const int top = std::max(strip_y, crop_y);
+    const int bottom = std::min(strip_y + strip.dimensions().height(), crop_y + crop_height);
+    for (int y = top; y < bottom; ++y)
+    {
+        const std::uint8_t* src = strip.indexes_ref().data() + (y - strip_y) * strip_width + crop_x;
+        std::uint8_t* dst = prefetching.indexes.data() + (y - crop_y) * crop_width;
+        std::copy(src, src + crop_width, dst);
+    }
+
+    // Rows below the crop aren't decompressed at all.
+    if (_streamer->done() || _streamer->streamed_rows() >= crop_y + crop_height)
+    {
+        prefetching.complete = true;
+        _streamer.reset();
+        _prefetching_slot = nullptr;
+    }
+
+    return false;
+}
+
+} // namespace jb::sys
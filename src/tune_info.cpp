@@ -1,8 +1,12 @@
 #include "tune_info.h"
 
+#include "gen/thumbnails.h"
+#include "gen/tune_metadata.h"
+#include "sys/thumbnail_item.h"
+#include "sys/tune_metadata.h"
+
 #include <bn_array.h>
 #include <bn_bitmap_bg.h>
-#include <bn_direct_bitmap_item.h>
 
 #include <algorithm>
 
@@ -18,23 +22,26 @@ namespace
 {
 
 constexpr tune_info TUNES_LIST_RAW[] = {
-    tune_info(bn::dmg_music_items::hell_owo_rld, tune_info::category::ORIGINAL, true, nullptr, "hellOWOrld",
-              "copyrat90", {},
+    tune_info(bn::dmg_music_items::hell_owo_rld, tune_info::category::ORIGINAL, true,
+              gen::tune_thumbnails::hell_owo_rld, gen::tune_metadata::hell_owo_rld, "hellOWOrld", "copyrat90", {},
               R"(First loop I wrote in FamiTracker years ago, later converted into hUGETracker format.
 
 Mostly inspired by Kitsune^2 - Naradno, Pachelbel - Canon in D and few other songs.)"),
-    tune_info(bn::dmg_music_items::puku_7, tune_info::category::TRANSCRIBE, true, nullptr,
-              "ぷくぷく天然かいらんばん - BGM #07", "さかもと ひでき", "copyrat90",
+    tune_info(bn::dmg_music_items::puku_7, tune_info::category::TRANSCRIBE, true, gen::tune_thumbnails::puku_7,
+              gen::tune_metadata::puku_7, "ぷくぷく天然かいらんばん - BGM #07", "さかもと ひでき", "copyrat90",
               R"(Ported a song from ぷくぷく天然かいらんばん just to practice using Furnace Tracker.
 
 Original song also has PCM channels, but unfortunately, they're missing in this port.)"),
-    tune_info(bn::dmg_music_items::spooky_birthday, tune_info::category::ORIGINAL, false, nullptr, "spooky birthday",
+    tune_info(bn::dmg_music_items::spooky_birthday, tune_info::category::ORIGINAL, false,
+              gen::tune_thumbnails::spooky_birthday, gen::tune_metadata::spooky_birthday, "spooky birthday",
               "copyrat90", {},
               R"(Spooky birthday jingle for my GBA Microjam '23 entry:
 Light the candles on the halloween cake!
 https://github.com/gbadev-org/microjam23)"),
-    tune_info(bn::dmg_music_items::safer_with_you, tune_info::category::TRANSCRIBE, true, nullptr, "Safer with You",
-              "valfrey", "copyrat90", R"(I wonder what happened to this game and the composer...)"),
+    tune_info(bn::dmg_music_items::safer_with_you, tune_info::category::TRANSCRIBE, true,
+              gen::tune_thumbnails::safer_with_you, gen::tune_metadata::safer_with_you, "Safer with You", "valfrey",
+              "copyrat90",
+              R"(I wonder what happened to this game and the composer...)"),
 };
 
 constexpr bn::span<const tune_info> TUNES_LIST(TUNES_LIST_RAW);
@@ -61,6 +68,10 @@ static_assert(std::ranges::all_of(TUNES_LIST,
                                   }),
               "Thumbnail too big");
 
+static_assert(std::ranges::all_of(TUNES_LIST,
+                                  [](const tune_info& info) { return !info.loop() || info.metadata().has_loop(); }),
+              "Looping tune without loop point");
+
 static_assert(
     [] {
         for (int l = 0; l < TUNES_LIST.size() - 1; ++l)
@@ -1,5 +1,6 @@
 #include "ui/menu_navigator.h"
 
+#include "dev/dev_counters.h"
 #include "directions.h"
 #include "ui/menu_navigator_builder.h"
 
@@ -65,13 +66,45 @@ void menu_navigator::update()
     if (_refresh_page_reserved)
     {
         _refresh_page_reserved = false;
-        commit_refresh_page();
+
+        if (_list_mode == list_mode::SCROLL)
+            commit_refresh_scroll_list();
+        else
+            commit_refresh_page();
+    }
+    else if (_list_mode == list_mode::SCROLL)
+    {
+        update_scroll_list();
+    }
+    else
+    {
+        render_pending_lines();
     }
 
     if (_input_enabled)
         handle_input();
 }
 
+bool menu_navigator::idle() const
+{
+    if (_refresh_page_reserved || !_pending_lines.empty() || _prev_held_directions != directions::NONE)
+        return false;
+
+    if (_list_mode == list_mode::SCROLL)
+    {
+        if (_list_scroll_y != static_cast<int>(_list_top_index) * get_line_height())
+            return false;
+
+        // Rows entering the viewport might not be rendered yet, when lines per frame is limited.
+        const int end_index = get_scroll_rows_end_index();
+        for (int index = get_scroll_rows_begin_index(); index < end_index; ++index)
+            if (_scroll_rows[index % get_scroll_rows_count()].menu_index != index)
+                return false;
+    }
+
+    return true;
+}
+
 bool menu_navigator::input_enabled() const
 {
     return _input_enabled;
@@ -100,10 +133,7 @@ void menu_navigator::set_pointed_index(unsigned index)
         _pointed_index = index;
         const auto new_page = get_page(_pointed_index);
 
-        if (new_page != prev_page)
-            reserve_refresh_page();
-        else
-            refresh_palette();
+        refresh_for_pointed_changed(prev_pointed_index);
 
         if (_pointed_changed_callback)
             _pointed_changed_callback(prev_page, prev_pointed_index, new_page, _pointed_index);
@@ -123,18 +153,21 @@ unsigned menu_navigator::total_pages() const
 menu_navigator::menu_navigator(const menu_navigator_builder& builder, sys::text_generators& text_gens)
     : _font(builder.font()), _text_gen(text_gens.get(_font)), _menu_strings(builder.menu_strings()),
       _menu_strings_2(builder.menu_strings_2()), _output_sprites(builder.output_sprites()),
-      _init_output_sprites_size(_output_sprites.size()), _pointed_palette(builder.pointed_palette()),
-      _unpointed_palette(builder.unpointed_palette()), _pointed_changed_callback(builder.pointed_changed_callback()),
+      _init_output_sprites_size(_output_sprites ? _output_sprites->size() : 0),
+      _pointed_palette(builder.pointed_palette()), _unpointed_palette(builder.unpointed_palette()),
+      _pointed_changed_callback(builder.pointed_changed_callback()),
       _activated_callback(builder.activated_callback()), _cancelled_callback(builder.cancelled_callback()),
       _pointed_changed_sfx(builder.pointed_changed_sfx()), _activated_sfx(builder.activated_sfx()),
       _activate_failed_sfx(builder.activate_failed_sfx()), _cancelled_sfx(builder.cancelled_sfx()),
-      _top_left_position(builder.top_left_position()),
+      _text_sprite_cache(builder.text_sprite_cache()), _top_left_position(builder.top_left_position()),
       _total_pages((_menu_strings.size() + builder.max_lines() - 1) / builder.max_lines()),
       _bg_priority(builder.bg_priority()), _line_margin(builder.line_margin()), _max_lines(builder.max_lines()),
       _scroll_start_delay(builder.scroll_start_delay()), _scroll_continue_delay(builder.scroll_continue_delay()),
-      _refresh_page_reserved(false), _input_enabled(builder.input_enabled()), _scrolling(false),
-      _scroll_delay(_scroll_start_delay), _prev_held_directions(directions::NONE),
-      _pointed_index(builder.pointed_index())
+      _lines_per_frame(builder.lines_per_frame()), _list_mode(builder.list_mode()),
+      _list_scroll_speed(builder.list_scroll_speed()), _refresh_page_reserved(false),
+      _input_enabled(builder.input_enabled()), _scrolling(false), _scroll_delay(_scroll_start_delay),
+      _prev_held_directions(directions::NONE), _pointed_index(builder.pointed_index()), _list_top_index(0),
+      _list_scroll_y(0)
 {
     reserve_refresh_page();
 }
@@ -192,10 +225,7 @@ void menu_navigator::handle_input()
         const auto prev_page = get_page(prev_pointed_index);
         const auto new_page = get_page(_pointed_index);
 
-        if (new_page != prev_page)
-            reserve_refresh_page();
-        else
-            refresh_palette();
+        refresh_for_pointed_changed(prev_pointed_index);
 
         if (_pointed_changed_callback)
             _pointed_changed_callback(prev_page, prev_pointed_index, new_page, _pointed_index);
@@ -246,57 +276,126 @@ void menu_navigator::reserve_refresh_page()
 
 void menu_navigator::commit_refresh_page()
 {
-    const unsigned page = this->page();
+    const unsigned lines = get_max_lines_for_index(_pointed_index);
+    const unsigned pointed_line = get_line(_pointed_index);
+
+    _lines_sprites.clear();
+    _pending_lines.clear();
 
-    _menu_spr_start_idxes.clear();
+    for (unsigned line = 0; line < lines; ++line)
+        _lines_sprites.push_back(line_sprites{0, 0, false});
+
+    // Reserve render in reverse order, so that the pointed line is rendered first.
+    for (int line = lines - 1; line >= 0; --line)
+        if (static_cast<unsigned>(line) != pointed_line)
+            _pending_lines.push_back(line);
+    _pending_lines.push_back(pointed_line);
+
+    render_pending_lines();
+}
+
+void menu_navigator::render_pending_lines()
+{
+    if (_pending_lines.empty())
+        return;
+
+    const unsigned page = this->page();
 
     // Render new sprite texts.
     bool failed = false;
     const auto prev_pal = _text_gen.palette_item();
-    for (unsigned line = 0; line < get_max_lines_for_index(_pointed_index); ++line)
+    for (unsigned count = 0; !_pending_lines.empty() && (_lines_per_frame == 0 || count < _lines_per_frame); ++count)
     {
-        const unsigned idx = page * _max_lines + line;
-        bn::fixed_point pos = get_line_pos(line);
-
-        _text_gen.set_palette_item(idx == _pointed_index ? _pointed_palette : _unpointed_palette);
-        _menu_spr_start_idxes.push_back(_output_sprites.size());
-
-        auto render_texts = [&](const bn::span<const bn::string_view>& menu_strings) {
-            if (!menu_strings.empty())
-            {
-                const bn::string_view& str = menu_strings[idx];
-                failed |= !_text_gen.generate_top_left_optional(pos, str, _output_sprites);
-                pos.set_x(pos.x() + _text_gen.width(str));
-            }
-        };
-
-        render_texts(_menu_strings);
-        render_texts(_menu_strings_2);
+        const unsigned line = _pending_lines.back();
+        _pending_lines.pop_back();
+
+        failed |= !render_line(page, line);
     }
     _text_gen.set_palette_item(prev_pal);
 
-    _menu_spr_start_idxes.push_back(_output_sprites.size());
+    if (failed)
+        BN_LOG_LEVEL(bn::log_level::WARN, "Failed generating text sprites for `menu_navigator`");
+
+    if constexpr (JB_DEVBUILD)
+    {
+        if (_text_sprite_cache && _pending_lines.empty())
+        {
+            dev::log_counter(dev::counter::TEXT_CACHE_HITS);
+            dev::log_counter(dev::counter::TEXT_CACHE_MISSES);
+        }
+    }
+}
+
+bool menu_navigator::render_line(unsigned page, unsigned line)
+{
+    const unsigned idx = page * _max_lines + line;
+    bn::fixed_point pos = get_line_pos(line);
+
+    // Palette is decided on render, so lines rendered late still follow the pointed index.
+    _text_gen.set_palette_item(idx == _pointed_index ? _pointed_palette : _unpointed_palette);
+
+    auto& output_sprites = *_output_sprites;
+    auto& line_sprs = _lines_sprites[line];
+    line_sprs.start_idx = static_cast<std::uint8_t>(output_sprites.size());
+
+    bool succeed = true;
+    auto render_texts = [&](const bn::span<const bn::string_view>& menu_strings) {
+        if (!menu_strings.empty())
+        {
+            const bn::string_view& str = menu_strings[idx];
+            succeed &= render_text(pos, str, output_sprites);
+            pos.set_x(pos.x() + _text_gen.width(str));
+        }
+    };
+
+    render_texts(_menu_strings);
+    render_texts(_menu_strings_2);
+
+    line_sprs.end_idx = static_cast<std::uint8_t>(output_sprites.size());
+    line_sprs.rendered = true;
 
     // Set bg priority of new sprites.
-    for (int idx = _init_output_sprites_size; idx < _output_sprites.size(); ++idx)
-        _output_sprites[idx].set_bg_priority(_bg_priority);
+    for (int spr_idx = line_sprs.start_idx; spr_idx < line_sprs.end_idx; ++spr_idx)
+        output_sprites[spr_idx].set_bg_priority(_bg_priority);
 
-    if (failed)
-        BN_LOG_LEVEL(bn::log_level::WARN, "Failed generating text sprites for `menu_navigator`");
+    return succeed;
+}
+
+bool menu_navigator::render_text(const bn::fixed_point& top_left_position, const bn::string_view& text,
+                                 bn::ivector<bn::sprite_ptr>& output_sprites)
+{
+    if (_text_sprite_cache && _text_sprite_cache->create_top_left(_font, text, top_left_position,
+                                                                  _text_gen.palette_item(), output_sprites))
+        return true;
+
+    const int start_idx = output_sprites.size();
+
+    if (!_text_gen.generate_top_left_optional(top_left_position, text, output_sprites))
+        return false;
+
+    if (_text_sprite_cache)
+        _text_sprite_cache->store(
+            _font, text, top_left_position,
+            bn::span<const bn::sprite_ptr>(output_sprites.data() + start_idx, output_sprites.size() - start_idx));
+
+    return true;
 }
 
 void menu_navigator::refresh_palette()
 {
-    if (_menu_spr_start_idxes.empty())
-        return;
+    const unsigned page = this->page();
 
-    for (unsigned line = 0; line < static_cast<unsigned>(_menu_spr_start_idxes.size()) - 1u; ++line)
+    for (unsigned line = 0; line < static_cast<unsigned>(_lines_sprites.size()); ++line)
     {
-        const unsigned menu_idx = page() * _max_lines + line;
+        const auto& line_sprs = _lines_sprites[line];
+        if (!line_sprs.rendered)
+            continue;
+
+        const unsigned menu_idx = page * _max_lines + line;
 
-        for (auto spr_idx = _menu_spr_start_idxes[line]; spr_idx < _menu_spr_start_idxes[line + 1]; ++spr_idx)
+        for (auto spr_idx = line_sprs.start_idx; spr_idx < line_sprs.end_idx; ++spr_idx)
         {
-            auto& spr = _output_sprites[spr_idx];
+            auto& spr = (*_output_sprites)[spr_idx];
 
             spr.set_palette(menu_idx == _pointed_index ? _pointed_palette : _unpointed_palette);
         }
@@ -305,10 +404,233 @@ void menu_navigator::refresh_palette()
 
 void menu_navigator::clear_page()
 {
-    while (_output_sprites.size() > _init_output_sprites_size)
-        _output_sprites.pop_back();
+    if (_output_sprites)
+    {
+        while (_output_sprites->size() > _init_output_sprites_size)
+            _output_sprites->pop_back();
+    }
+
+    _lines_sprites.clear();
+    _pending_lines.clear();
+
+    clear_scroll_rows();
+}
+
+void menu_navigator::refresh_for_pointed_changed(unsigned prev_pointed_index)
+{
+    if (_list_mode == list_mode::SCROLL)
+    {
+        const unsigned prev_top_index = _list_top_index;
+        fit_list_top_index();
+
+        const unsigned top_index_diff =
+            (prev_top_index > _list_top_index) ? prev_top_index - _list_top_index : _list_top_index - prev_top_index;
+
+        // Jumped too far (e.g. wrapped around), so snap to it instead of scrolling through.
+        if (top_index_diff > _max_lines)
+        {
+            reserve_refresh_page();
+        }
+        else
+        {
+            recolor_scroll_row(prev_pointed_index);
+            recolor_scroll_row(_pointed_index);
+        }
+    }
+    else if (get_page(prev_pointed_index) != get_page(_pointed_index))
+    {
+        reserve_refresh_page();
+    }
+    else
+    {
+        refresh_palette();
+    }
+}
+
+void menu_navigator::commit_refresh_scroll_list()
+{
+    fit_list_top_index();
+
+    // Snap to the top index.
+    _list_scroll_y = _list_top_index * get_line_height();
+
+    render_scroll_rows();
+}
+
+void menu_navigator::update_scroll_list()
+{
+    // Scroll towards the top index.
+    const int target_scroll_y = _list_top_index * get_line_height();
+    const int prev_scroll_y = _list_scroll_y;
+
+    if (_list_scroll_y < target_scroll_y)
+        _list_scroll_y = std::min(_list_scroll_y + _list_scroll_speed, target_scroll_y);
+    else if (_list_scroll_y > target_scroll_y)
+        _list_scroll_y = std::max(_list_scroll_y - _list_scroll_speed, target_scroll_y);
+
+    if (_list_scroll_y != prev_scroll_y)
+        reposition_scroll_rows();
+
+    // Only the rows entering the viewport are rendered here.
+    render_scroll_rows();
+}
+
+void menu_navigator::render_scroll_rows()
+{
+    const int begin_index = get_scroll_rows_begin_index();
+    const int end_index = get_scroll_rows_end_index();
+
+    bool failed = false;
+    unsigned rendered_count = 0;
+    const auto prev_pal = _text_gen.palette_item();
+
+    auto render_row = [&](int index) {
+        if (_lines_per_frame != 0 && rendered_count >= _lines_per_frame)
+            return;
+
+        if (get_scroll_row(index).menu_index != index)
+        {
+            failed |= !render_scroll_row(index);
+            ++rendered_count;
+        }
+    };
+
+    // Render the pointed row first.
+    if (static_cast<int>(_pointed_index) >= begin_index && static_cast<int>(_pointed_index) < end_index)
+        render_row(_pointed_index);
+
+    for (int index = begin_index; index < end_index; ++index)
+        render_row(index);
+
+    _text_gen.set_palette_item(prev_pal);
+
+    if (failed)
+        BN_LOG_LEVEL(bn::log_level::WARN, "Failed generating text sprites for `menu_navigator`");
+}
+
+bool menu_navigator::render_scroll_row(unsigned index)
+{
+    scroll_row& row = get_scroll_row(index);
+
+    // Reuse the ring slot of the row that left the viewport.
+    row.sprites.clear();
+    row.menu_index = index;
+    row.y = get_scroll_row_y(index);
+
+    _text_gen.set_palette_item(index == _pointed_index ? _pointed_palette : _unpointed_palette);
+
+    bool succeed = true;
+    bn::fixed_point pos(get_line_x(), row.y);
+    auto render_texts = [&](const bn::span<const bn::string_view>& menu_strings) {
+        if (!menu_strings.empty())
+        {
+            const bn::string_view& str = menu_strings[index];
+            succeed &= render_text(pos, str, row.sprites);
+            pos.set_x(pos.x() + _text_gen.width(str));
+        }
+    };
+
+    render_texts(_menu_strings);
+    render_texts(_menu_strings_2);
+
+    const bool visible = is_scroll_row_visible(row.y);
+    for (bn::sprite_ptr& spr : row.sprites)
+    {
+        spr.set_bg_priority(_bg_priority);
+        spr.set_visible(visible);
+    }
+
+    return succeed;
+}
+
+void menu_navigator::reposition_scroll_rows()
+{
+    for (scroll_row& row : _scroll_rows)
+    {
+        if (row.menu_index < 0)
+            continue;
+
+        const bn::fixed new_y = get_scroll_row_y(row.menu_index);
+        const bn::fixed diff_y = new_y - row.y;
+        row.y = new_y;
+
+        const bool visible = is_scroll_row_visible(row.y);
+        for (bn::sprite_ptr& spr : row.sprites)
+        {
+            spr.set_y(spr.y() + diff_y);
+            spr.set_visible(visible);
+        }
+    }
+}
+
+void menu_navigator::recolor_scroll_row(unsigned index)
+{
+    scroll_row& row = get_scroll_row(index);
+    if (row.menu_index != static_cast<int>(index))
+        return;
 
-    _menu_spr_start_idxes.clear();
+    for (bn::sprite_ptr& spr : row.sprites)
+        spr.set_palette(index == _pointed_index ? _pointed_palette : _unpointed_palette);
+}
+
+void menu_navigator::clear_scroll_rows()
+{
+    for (scroll_row& row : _scroll_rows)
+    {
+        row.menu_index = -1;
+        row.sprites.clear();
+    }
+}
+
+void menu_navigator::fit_list_top_index()
+{
+    // Scroll just enough to show the pointed row.
+    if (_pointed_index < _list_top_index)
+        _list_top_index = _pointed_index;
+    else if (_pointed_index >= _list_top_index + _max_lines)
+        _list_top_index = _pointed_index - _max_lines + 1;
+
+    // Don't scroll past the last row.
+    const unsigned menus_count = _menu_strings.size();
+    const unsigned max_top_index = (menus_count > _max_lines) ? menus_count - _max_lines : 0;
+    _list_top_index = std::min(_list_top_index, max_top_index);
+}
+
+auto menu_navigator::get_scroll_row(unsigned index) -> scroll_row&
+{
+    return _scroll_rows[index % get_scroll_rows_count()];
+}
+
+int menu_navigator::get_scroll_rows_begin_index() const
+{
+    const int first_visible_index = _list_scroll_y / get_line_height();
+
+    return std::max(first_visible_index - 1, 0);
+}
+
+int menu_navigator::get_scroll_rows_end_index() const
+{
+    const int first_visible_index = _list_scroll_y / get_line_height();
+    const int menus_count = _menu_strings.size();
+
+    return std::min(first_visible_index + _max_lines + 1, menus_count);
+}
+
+unsigned menu_navigator::get_scroll_rows_count() const
+{
+    return _max_lines + 2u;
+}
+
+auto menu_navigator::get_scroll_row_y(unsigned index) const -> bn::fixed
+{
+    return _top_left_position.y() + static_cast<int>(index) * get_line_height() - _list_scroll_y;
+}
+
+bool menu_navigator::is_scroll_row_visible(bn::fixed row_y) const
+{
+    const bn::fixed viewport_bottom = _top_left_position.y() + _max_lines * get_line_height();
+
+    return row_y >= _top_left_position.y() && row_y + FONT_HEIGHTS[(int)_font] <= viewport_bottom;
 }
 
 unsigned menu_navigator::get_page(unsigned index) const
@@ -338,7 +660,7 @@ auto menu_navigator::get_line_x() const -> bn::fixed
 
 auto menu_navigator::get_line_y(unsigned line) const -> bn::fixed
 {
-    return _top_left_position.y() + line * (FONT_HEIGHTS[(int)_font] + _line_margin);
+    return _top_left_position.y() + line * get_line_height();
 }
 
 auto menu_navigator::get_line_pos(unsigned line) const -> bn::fixed_point
@@ -346,6 +668,11 @@ auto menu_navigator::get_line_pos(unsigned line) const -> bn::fixed_point
     return bn::fixed_point(get_line_x(), get_line_y(line));
 }
 
+int menu_navigator::get_line_height() const
+{
+    return FONT_HEIGHTS[(int)_font] + _line_margin;
+}
+
 auto menu_navigator::get_menu_x() const -> bn::fixed
 {
     return get_line_x();
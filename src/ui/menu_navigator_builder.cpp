@@ -27,11 +27,19 @@ constexpr bn::sprite_palette_item DEFAULT_UNPOINTED_PALETTE(DEFAULT_UNPOINTED_CO
 menu_navigator_builder::menu_navigator_builder(sys::text_generators::font font,
                                                bn::span<const bn::string_view> menu_strings,
                                                bn::ivector<bn::sprite_ptr>& output_sprites)
-    : _font(font), _menu_strings(menu_strings), _output_sprites(output_sprites),
+    : menu_navigator_builder(font, menu_strings)
+{
+    _output_sprites = &output_sprites;
+}
+
+menu_navigator_builder::menu_navigator_builder(sys::text_generators::font font,
+                                               bn::span<const bn::string_view> menu_strings)
+    : _font(font), _menu_strings(menu_strings), _output_sprites(nullptr),
       _pointed_palette(DEFAULT_POINTED_PALETTE), _unpointed_palette(DEFAULT_UNPOINTED_PALETTE),
       _pointed_changed_sfx(nullptr), _activated_sfx(nullptr), _activate_failed_sfx(nullptr), _cancelled_sfx(nullptr),
-      _bg_priority(BG_PRIORITY), _line_margin(DEFAULT_MARGINS[(int)font]), _max_lines(menu_strings.size()),
-      _scroll_start_delay(30), _scroll_continue_delay(6), _input_enabled(true), _pointed_index(0)
+      _text_sprite_cache(nullptr), _bg_priority(BG_PRIORITY), _line_margin(DEFAULT_MARGINS[(int)font]),
+      _max_lines(menu_strings.size()), _scroll_start_delay(30), _scroll_continue_delay(6), _lines_per_frame(0),
+      _list_mode(menu_navigator::list_mode::PAGE), _list_scroll_speed(4), _input_enabled(true), _pointed_index(0)
 {
     BN_ASSERT(menu_strings.size() != 0, "At least one menu should exist");
 }
@@ -41,6 +49,8 @@ auto menu_navigator_builder::build(sys::text_generators& text_gens) -> menu_navi
     if (!_menu_strings_2.empty())
         BN_ASSERT(_menu_strings_2.size() == _menu_strings.size(), "strings_2 size mismatch: ", _menu_strings_2.size(),
                   " - ", _menu_strings.size());
+    BN_ASSERT(_output_sprites || _list_mode == menu_navigator::list_mode::SCROLL,
+              "Output sprites are required for list_mode::PAGE");
 
     return menu_navigator(*this, text_gens);
 }
@@ -55,7 +65,7 @@ auto menu_navigator_builder::menu_strings() const -> bn::span<const bn::string_v
     return _menu_strings;
 }
 
-auto menu_navigator_builder::output_sprites() const -> bn::ivector<bn::sprite_ptr>&
+auto menu_navigator_builder::output_sprites() const -> bn::ivector<bn::sprite_ptr>*
 {
     return _output_sprites;
 }
@@ -160,6 +170,57 @@ auto menu_navigator_builder::set_scroll_continue_delay(unsigned delay) -> menu_n
     return *this;
 }
 
+unsigned menu_navigator_builder::lines_per_frame() const
+{
+    return _lines_per_frame;
+}
+
+auto menu_navigator_builder::set_lines_per_frame(unsigned lines) -> menu_navigator_builder&
+{
+    static constexpr auto MAX = std::numeric_limits<decltype(_lines_per_frame)>::max();
+    BN_ASSERT(lines <= MAX, "Too many lines per frame: ", lines, " (max ", (unsigned)MAX, ")");
+
+    _lines_per_frame = lines;
+    return *this;
+}
+
+auto menu_navigator_builder::list_mode() const -> menu_navigator::list_mode
+{
+    return _list_mode;
+}
+
+auto menu_navigator_builder::set_list_mode(menu_navigator::list_mode mode) -> menu_navigator_builder&
+{
+    _list_mode = mode;
+    return *this;
+}
+
+unsigned menu_navigator_builder::list_scroll_speed() const
+{
+    return _list_scroll_speed;
+}
+
+auto menu_navigator_builder::set_list_scroll_speed(unsigned speed) -> menu_navigator_builder&
+{
+    static constexpr auto MAX = std::numeric_limits<decltype(_list_scroll_speed)>::max();
+    BN_ASSERT(speed <= MAX, "Too fast scroll speed: ", speed, " (max ", (unsigned)MAX, ")");
+    BN_ASSERT(speed != 0, "Scroll speed can't be zero");
+
+    _list_scroll_speed = speed;
+    return *this;
+}
+
+auto menu_navigator_builder::text_sprite_cache() const -> sys::text_sprite_cache*
+{
+    return _text_sprite_cache;
+}
+
+auto menu_navigator_builder::set_text_sprite_cache(sys::text_sprite_cache* cache) -> menu_navigator_builder&
+{
+    _text_sprite_cache = cache;
+    return *this;
+}
+
 bool menu_navigator_builder::input_enabled() const
 {
     return _input_enabled;
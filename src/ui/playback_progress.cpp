@@ -0,0 +1,209 @@
+#include "ui/playback_progress.h"
+
+#include "dev/dev_counters.h"
+#include "sys/playback_service.h"
+#include "sys/tune_metadata.h"
+
+#include <bn_assert.h>
+#include <bn_color.h>
+#include <bn_display.h>
+#include <bn_sprite_palette_item.h>
+#include <bn_sprite_shape_size.h>
+#include <bn_sprite_tiles_item.h>
+#include <bn_sstream.h>
+#include <bn_string.h>
+#include <bn_tile.h>
+#include <bn_timer.h>
+
+namespace jb::ui
+{
+
+namespace
+{
+
+constexpr bn::string_view DIGITS = "0123456789";
+
+constexpr int BAR_WIDTH = bn::display::width();
+constexpr int BAR_SPRITE_WIDTH = 32;
+constexpr bn::sprite_shape_size BAR_SHAPE_SIZE(bn::sprite_shape::WIDE, bn::sprite_size::NORMAL);
+
+static_assert(playback_progress::BAR_SPRITES_COUNT * BAR_SPRITE_WIDTH >= BAR_WIDTH);
+
+/// Top 2 rows of the tile are filled with the color 1.
+constexpr bn::tile BAR_TILE = {{0x11111111, 0x11111111, 0, 0, 0, 0, 0, 0}};
+constexpr bn::tile BAR_TILES[] = {BAR_TILE, BAR_TILE, BAR_TILE, BAR_TILE};
+
+constexpr bn::color BAR_COLORS[16] = {bn::color(), bn::color(0x5294)};
+
+constexpr bn::sprite_tiles_item BAR_TILES_ITEM(BAR_TILES, bn::bpp_mode::BPP_4);
+constexpr bn::sprite_palette_item BAR_PALETTE_ITEM(BAR_COLORS, bn::bpp_mode::BPP_4);
+
+void append_time(bn::ostringstream& oss, int seconds, int minutes_digits)
+{
+    const int minutes = seconds / 60;
+    if (minutes_digits > 1 && minutes < 10)
+        oss << '0';
+    oss << minutes << ':';
+    if (seconds % 60 < 10)
+        oss << '0';
+    oss << seconds % 60;
+}
+
+} // namespace
+
+playback_progress::playback_progress(sys::text_generators& text_gens) : _text_gens(text_gens)
+{
+}
+
+void playback_progress::show(const sys::tune_metadata& metadata, int elapsed_ticks,
+                             const bn::fixed_point& top_right_position, int bar_top)
+{
+    _metadata = &metadata;
+    _time_sprites.clear();
+    _bar_sprites.clear();
+
+    if (_digit_tiles.empty())
+        render_digit_glyphs();
+
+    // "0:00/2:40", which is the only time the text is generated for the tune.
+    // Times are in real seconds, as a tick is played each frame instead of at the tick rate of the module.
+    const int total_seconds =
+        (bn::fixed(metadata.total_ticks()) / sys::playback_service::TICKS_PER_SECOND).floor_integer();
+    BN_ASSERT(total_seconds < 100 * 60, "Too long tune: ", total_seconds);
+    _minutes_digits = total_seconds >= 10 * 60 ? 2 : 1;
+
+    bn::string<MAX_TIME_CHARS> str;
+    bn::ostringstream oss(str);
+    append_time(oss, 0, _minutes_digits);
+    oss << '/';
+    append_time(oss, total_seconds, _minutes_digits);
+
+    auto& gen = _text_gens.get(FONT);
+    const bool prev_one_sprite_per_character = gen.one_sprite_per_character();
+    gen.set_one_sprite_per_character(true);
+
+    _time_left = top_right_position.x().floor_integer() - gen.width(str);
+    const bn::fixed_point time_pos(_time_left, top_right_position.y());
+    if (!gen.generate_top_left_optional(time_pos, str, _time_sprites) || _time_sprites.size() != str.size())
+        _time_sprites.clear();
+
+    gen.set_one_sprite_per_character(prev_one_sprite_per_character);
+
+    // Bar sprites share the same tiles and palette.
+    const bn::sprite_tiles_ptr bar_tiles = BAR_TILES_ITEM.create_tiles();
+    const bn::sprite_palette_ptr bar_palette = BAR_PALETTE_ITEM.create_palette();
+    for (int i = 0; i < BAR_SPRITES_COUNT; ++i)
+        _bar_sprites.push_back(bn::sprite_ptr::create(bn::fixed_point(), BAR_SHAPE_SIZE, bar_tiles, bar_palette));
+    _bar_top = bar_top;
+
+    _shown_seconds = -1;
+    _shown_bar_width = -1;
+    _shown_digits.fill(-1);
+    update_sprites(elapsed_ticks);
+}
+
+void playback_progress::hide()
+{
+    _metadata = nullptr;
+    _time_sprites.clear();
+    _bar_sprites.clear();
+    _digit_tiles.clear();
+}
+
+bool playback_progress::shown() const
+{
+    return _metadata != nullptr;
+}
+
+int playback_progress::time_left() const
+{
+    return _time_left;
+}
+
+void playback_progress::update(int elapsed_ticks)
+{
+    if (!shown())
+        return;
+
+    if constexpr (JB_DEVBUILD)
+    {
+        bn::timer timer;
+        update_sprites(elapsed_ticks);
+        const int ticks = timer.elapsed_ticks();
+
+        if (ticks > dev::counter_value(dev::counter::PROGRESS_UPDATE_MAX_TICKS))
+        {
+            dev::set_counter(dev::counter::PROGRESS_UPDATE_MAX_TICKS, ticks);
+            dev::log_counter(dev::counter::PROGRESS_UPDATE_MAX_TICKS);
+        }
+    }
+    else
+    {
+        update_sprites(elapsed_ticks);
+    }
+}
+
+void playback_progress::render_digit_glyphs()
+{
+    auto& gen = _text_gens.get(FONT);
+    const bool prev_one_sprite_per_character = gen.one_sprite_per_character();
+    gen.set_one_sprite_per_character(true);
+
+    // Only the tiles are kept, so the sprites are released before they're ever displayed.
+    bn::vector<bn::sprite_ptr, 10> glyph_sprites;
+    if (gen.generate_top_left_optional(bn::fixed_point(), DIGITS, glyph_sprites) &&
+        glyph_sprites.size() == DIGITS.size())
+    {
+        for (const bn::sprite_ptr& glyph_sprite : glyph_sprites)
+            _digit_tiles.push_back(glyph_sprite.tiles());
+    }
+
+    gen.set_one_sprite_per_character(prev_one_sprite_per_character);
+}
+
+void playback_progress::update_sprites(int elapsed_ticks)
+{
+    const sys::tune_metadata& metadata = *_metadata;
+    const int ticks = metadata.position_ticks(elapsed_ticks);
+
+    const int bar_width = ticks * BAR_WIDTH / metadata.total_ticks();
+    if (bar_width != _shown_bar_width)
+    {
+        _shown_bar_width = bar_width;
+
+        // Part of the bar left to the screen isn't displayed.
+        int x = bar_width - BAR_SPRITES_COUNT * BAR_SPRITE_WIDTH;
+        for (bn::sprite_ptr& bar_sprite : _bar_sprites)
+        {
+            bar_sprite.set_top_left_position(bn::fixed_point(x, _bar_top));
+            x += BAR_SPRITE_WIDTH;
+        }
+    }
+
+    const int seconds = (bn::fixed(ticks) / sys::playback_service::TICKS_PER_SECOND).floor_integer();
+    if (seconds == _shown_seconds || _time_sprites.empty() || _digit_tiles.empty())
+        return;
+
+    _shown_seconds = seconds;
+
+    const int minutes = seconds / 60;
+    bn::array<int, MAX_MINUTES_DIGITS + 2> digits;
+    digits[0] = minutes / 10;
+    digits[1] = minutes % 10;
+    digits[2] = seconds % 60 / 10;
+    digits[3] = seconds % 60 % 10;
+
+    // Skip the tens of minutes if it's not shown, and ':' after the minutes.
+    for (int i = MAX_MINUTES_DIGITS - _minutes_digits; i < digits.size(); ++i)
+    {
+        if (digits[i] == _shown_digits[i])
+            continue;
+
+        _shown_digits[i] = digits[i];
+
+        const int char_idx = i - (MAX_MINUTES_DIGITS - _minutes_digits) + (i >= MAX_MINUTES_DIGITS ? 1 : 0);
+        _time_sprites[char_idx].set_tiles(_digit_tiles[digits[i]]);
+    }
+}
+
+} // namespace jb::ui
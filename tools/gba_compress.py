@@ -0,0 +1,255 @@
+"""GBA BIOS compatible compressors.
+
+`sys::bitmap_streamer` and butano can decompress these.
+"""
+
+from typing import Dict, Final, List, Optional, Tuple
+import heapq
+
+LZ77_TYPE: Final[int] = 0x10
+HUFFMAN_TYPE: Final[int] = 0x20
+RUN_LENGTH_TYPE: Final[int] = 0x30
+
+LZ77_MIN_LENGTH: Final[int] = 3
+LZ77_MAX_LENGTH: Final[int] = 18
+LZ77_WINDOW: Final[int] = 4096
+LZ77_MAX_CHAIN: Final[int] = 64
+
+RUN_LENGTH_MIN_RUN: Final[int] = 3
+RUN_LENGTH_MAX_RUN: Final[int] = 130
+RUN_LENGTH_MAX_RAW: Final[int] = 128
+
+HUFFMAN_MAX_NODE_OFFSET: Final[int] = 0x3F
+
+
+def _header(type_byte: int, size: int) -> bytearray:
+    return bytearray(
+        [type_byte, size & 0xFF, (size >> 8) & 0xFF, (size >> 16) & 0xFF]
+    )
+
+
+def _pad(data: bytearray) -> bytes:
+    """Pads to a multiple of 4 bytes, as the BIOS reads the source in words."""
+
+    data.extend(bytes(-len(data) % 4))
+    return bytes(data)
+
+
+def compress_lz77(data: bytes) -> bytes:
+    out = _header(LZ77_TYPE, len(data))
+
+    # Positions of each 3 bytes prefix, newest last.
+    chains: Dict[bytes, List[int]] = {}
+
+    def insert(pos: int):
+        if pos + LZ77_MIN_LENGTH <= len(data):
+            chain = chains.setdefault(data[pos : pos + LZ77_MIN_LENGTH], [])
+            chain.append(pos)
+            if len(chain) > LZ77_MAX_CHAIN:
+                del chain[0]
+
+    pos = 0
+    while pos < len(data):
+        flags_pos = len(out)
+        out.append(0)
+
+        for block in range(8):
+            if pos >= len(data):
+                break
+
+            best_length = 0
+            best_displacement = 0
+            max_length = min(LZ77_MAX_LENGTH, len(data) - pos)
+            for candidate in reversed(
+                chains.get(data[pos : pos + LZ77_MIN_LENGTH], [])
+            ):
+                if pos - candidate > LZ77_WINDOW:
+                    break
+                length = 0
+                while (
+                    length < max_length
+                    and data[candidate + length] == data[pos + length]
+                ):
+                    length += 1
+                if length > best_length:
+                    best_length = length
+                    best_displacement = pos - candidate
+                    if length == max_length:
+                        break
+
+            if best_length >= LZ77_MIN_LENGTH:
+                out[flags_pos] |= 0x80 >> block
+                encoded_displacement = best_displacement - 1
+                out.append(
+                    ((best_length - LZ77_MIN_LENGTH) << 4)
+                    | (encoded_displacement >> 8)
+                )
+                out.append(encoded_displacement & 0xFF)
+                for _ in range(best_length):
+                    insert(pos)
+                    pos += 1
+            else:
+                out.append(data[pos])
+                insert(pos)
+                pos += 1
+
+    return _pad(out)
+
+
+def compress_run_length(data: bytes) -> bytes:
+    out = _header(RUN_LENGTH_TYPE, len(data))
+    raw = bytearray()
+
+    def flush_raw():
+        for start in range(0, len(raw), RUN_LENGTH_MAX_RAW):
+            chunk = raw[start : start + RUN_LENGTH_MAX_RAW]
+            out.append(len(chunk) - 1)
+            out.extend(chunk)
+        raw.clear()
+
+    pos = 0
+    while pos < len(data):
+        run = 1
+        while (
+            pos + run < len(data)
+            and run < RUN_LENGTH_MAX_RUN
+            and data[pos + run] == data[pos]
+        ):
+            run += 1
+
+        if run >= RUN_LENGTH_MIN_RUN:
+            flush_raw()
+            out.append(0x80 | (run - RUN_LENGTH_MIN_RUN))
+            out.append(data[pos])
+            pos += run
+        else:
+            raw.append(data[pos])
+            pos += 1
+
+    flush_raw()
+    return _pad(out)
+
+
+def _huffman_codes(
+    frequencies: Dict[int, int]
+) -> Tuple[List[Tuple[int, int]], Dict[int, str]]:
+    """Builds the Huffman tree.
+
+    Returns the nodes as `(left, right)` children pairs, where a negative child is
+    the leaf of the symbol `-child - 1`, and the codes of the symbols.
+    The last node is the root.
+    """
+
+    # Single symbol still needs a pair of children.
+    if len(frequencies) == 1:
+        frequencies = {**frequencies, next(iter(frequencies)) ^ 1: 0}
+
+    nodes: List[Tuple[int, int]] = []
+    heap: List[Tuple[int, int, int]] = [
+        (frequency, order, -symbol - 1)
+        for order, (symbol, frequency) in enumerate(sorted(frequencies.items()))
+    ]
+    heapq.heapify(heap)
+    order = len(heap)
+    while len(heap) > 1:
+        left_frequency, _, left = heapq.heappop(heap)
+        right_frequency, _, right = heapq.heappop(heap)
+        nodes.append((left, right))
+        heapq.heappush(
+            heap, (left_frequency + right_frequency, order, len(nodes) - 1)
+        )
+        order += 1
+
+    codes: Dict[int, str] = {}
+
+    def walk(child: int, code: str):
+        if child < 0:
+            codes[-child - 1] = code
+        else:
+            walk(nodes[child][0], code + "0")
+            walk(nodes[child][1], code + "1")
+
+    walk(len(nodes) - 1, "")
+    return nodes, codes
+
+
+def _huffman_tree_table(nodes: List[Tuple[int, int]]) -> Optional[bytearray]:
+    """Lays out the tree in the BIOS format, in breadth first order.
+
+    Returns `None` if a node is too far from its children to encode the offset.
+    """
+
+    # Index 0 is the tree size, and index 1 is the root.
+    root = len(nodes) - 1
+    queue: List[Tuple[int, int]] = [(root, 1)]
+    next_pair_index = 2
+    entries: Dict[int, int] = {}
+
+    head = 0
+    while head < len(queue):
+        node, index = queue[head]
+        head += 1
+
+        pair_index = next_pair_index
+        next_pair_index += 2
+        offset = (pair_index - (index & ~1) - 2) // 2
+        if offset > HUFFMAN_MAX_NODE_OFFSET:
+            return None
+
+        value = offset
+        for side, child in enumerate(nodes[node]):
+            if child < 0:
+                value |= 0x80 >> side
+                entries[pair_index + side] = -child - 1
+            else:
+                queue.append((child, pair_index + side))
+        entries[index] = value
+
+    table_bytes = next_pair_index
+    table_bytes += -table_bytes % 4
+    out = bytearray(table_bytes)
+    out[0] = table_bytes // 2 - 1
+    for index, value in entries.items():
+        out[index] = value
+    return out
+
+
+def compress_huffman(data: bytes, symbol_bits: int = 8) -> Optional[bytes]:
+    """Returns `None` if the tree can't be encoded in the BIOS format."""
+
+    assert symbol_bits in (4, 8)
+
+    symbols: List[int] = []
+    for byte in data:
+        if symbol_bits == 8:
+            symbols.append(byte)
+        else:
+            symbols.extend((byte & 0xF, byte >> 4))
+
+    frequencies: Dict[int, int] = {}
+    for symbol in symbols:
+        frequencies[symbol] = frequencies.get(symbol, 0) + 1
+
+    nodes, codes = _huffman_codes(frequencies)
+    tree_table = _huffman_tree_table(nodes)
+    if tree_table is None:
+        return None
+
+    out = _header(HUFFMAN_TYPE | symbol_bits, len(data))
+    out.extend(tree_table)
+
+    # 32-bit little endian words, which are read from the most significant bit.
+    word = 0
+    word_bits = 0
+    for symbol in symbols:
+        for bit in codes[symbol]:
+            word = (word << 1) | (bit == "1")
+            word_bits += 1
+            if word_bits == 32:
+                out.extend(word.to_bytes(4, "little"))
+                word = 0
+                word_bits = 0
+    if word_bits:
+        out.extend((word << (32 - word_bits)).to_bytes(4, "little"))
+
+    return _pad(out)
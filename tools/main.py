@@ -32,12 +32,16 @@ if __name__ == "__main__":
     parser.add_argument("--texts", required=False, help="texts forder or files")
     parser.add_argument("--fonts-build", required=True, help="fonts build folder")
     parser.add_argument("--licenses", required=True, help="licenses folder")
+    parser.add_argument("--thumbnails", required=True, help="thumbnails folder")
+    parser.add_argument("--dmg-audio", required=True, help="dmg audio folder")
     parser.add_argument("--misc-build", required=True, help="misc build folder")
 
     try:
         args = parser.parse_args()
         fonts_build = Path(args.fonts_build)
         licenses = Path(args.licenses)
+        thumbnails = Path(args.thumbnails)
+        dmg_audio = Path(args.dmg_audio)
         misc_build = Path(args.misc_build)
 
         fonts_build.mkdir(parents=True, exist_ok=True)
@@ -50,7 +54,9 @@ if __name__ == "__main__":
 
         import misc_writer
 
-        misc_writer.write_miscs(licenses, misc_build)
+        misc_writer.write_miscs(
+            licenses, fonts_build, thumbnails, dmg_audio, misc_build
+        )
 
     except Exception as ex:
         sys.stderr.write(f"Error: {ex}\n")
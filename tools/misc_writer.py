@@ -3,8 +3,18 @@ from typing import Final, List
 from dataclasses import dataclass
 from datetime import datetime
 
+import text_compressor
+import text_paginator
+import thumbnail_writer
+import tune_analyzer
+
 NAMESPACE: Final[str] = "jb"
 
+# Should match the layout of `scn::license_print`.
+LICENSE_FONT: Final[str] = "galmuri7"
+LICENSE_LINE_WIDTH: Final[int] = 240 - 2 * 10
+LICENSE_PAGE_LINES: Final[int] = 14
+
 
 def remove_built_files(build_folder_path: Path):
     for path in build_folder_path.joinpath("include/gen").glob("*.h"):
@@ -14,7 +24,10 @@ def remove_built_files(build_folder_path: Path):
 
 
 def write_license_header(
-    license_folder_path: Path, build_folder_path: Path, tools_mtime: float
+    license_folder_path: Path,
+    fonts_build_folder_path: Path,
+    build_folder_path: Path,
+    tools_mtime: float,
 ):
     build_include_path = build_folder_path.joinpath("include/gen")
     license_header_path = build_include_path.joinpath("licenses.h")
@@ -22,10 +35,13 @@ def write_license_header(
     @dataclass
     class LicenseInfo:
         name: str
-        content: str
+        pages: List[bytes]
 
     license_paths = sorted(license_folder_path.rglob("*.*"))
-    src_mtime: float = 0.0
+    font_header_path = fonts_build_folder_path.joinpath(
+        f"{LICENSE_FONT}_sprite_font.h"
+    )
+    src_mtime: float = font_header_path.stat().st_mtime
     for license_path in license_paths:
         src_mtime = max(src_mtime, license_path.stat().st_mtime)
 
@@ -36,13 +52,28 @@ def write_license_header(
     ):
         return
 
+    widths = text_paginator.read_sprite_font_widths(font_header_path)
+
     license_infos: List[LicenseInfo] = []
     for license_path in license_paths:
         with open(license_path, encoding="utf-8") as license_file:
             license_infos.append(
-                LicenseInfo(license_path.stem.replace("_", "-"), license_file.read())
+                LicenseInfo(
+                    license_path.stem.replace("_", "-"),
+                    text_paginator.paginate(
+                        license_file.read(),
+                        widths,
+                        LICENSE_LINE_WIDTH,
+                        LICENSE_PAGE_LINES,
+                        text_compressor.MAX_BLOCK_BYTES,
+                    ),
+                )
             )
 
+    dictionary = text_compressor.build_dictionary(
+        [b"\n".join(info.pages) for info in license_infos]
+    )
+
     with open(license_header_path, "w", encoding="utf-8") as header:
         header.write(f"// Generated by `misc_writer.py` in {datetime.now()}\n")
         header.write("//\n")
@@ -51,12 +82,18 @@ def write_license_header(
         )
         header.write("#pragma once\n\n")
 
+        header.write('#include "sys/compressed_text.h"\n\n')
         header.write("#include <bn_array.h>\n")
         header.write("#include <bn_string_view.h>\n\n")
+        header.write("#include <cstdint>\n\n")
 
         header.write(f"namespace {NAMESPACE}::gen\n")
         header.write("{\n\n")
 
+        header.write(
+            f"inline constexpr int LICENSE_PAGE_LINES = {LICENSE_PAGE_LINES};\n\n"
+        )
+
         header.write(
             f"inline constexpr bn::array<const bn::string_view, {len(license_infos)}> LICENSE_NAMES = {{\n"
         )
@@ -64,17 +101,64 @@ def write_license_header(
             header.write(f'R"({license_info.name})",\n')
         header.write("};\n\n")
 
+        def write_bytes(name: str, data: bytes):
+            header.write(f"inline constexpr std::uint8_t {name}[] = {{\n")
+            for offset in range(0, len(data), 32):
+                row = data[offset : offset + 32]
+                header.write(",".join(f"{byte:#04x}" for byte in row) + ",\n")
+            header.write("};\n\n")
+
+        write_bytes("LICENSE_DICTIONARY", dictionary)
+
+        raw_bytes = 0
+        compressed_bytes = 0
+        for idx, license_info in enumerate(license_infos):
+            data = bytearray()
+            block_ends: List[int] = []
+            for page in license_info.pages:
+                compressed = text_compressor.compress_block(page, dictionary)
+                assert text_compressor.decompress_block(compressed, dictionary) == page
+                data.extend(compressed)
+                block_ends.append(len(data))
+
+            raw_bytes += sum(len(page) for page in license_info.pages)
+            compressed_bytes += len(data) + len(block_ends) * 2
+
+            write_bytes(f"LICENSE_DATA_{idx}", data)
+            header.write(
+                f"inline constexpr std::uint16_t LICENSE_BLOCK_ENDS_{idx}[] = {{"
+                + ",".join(str(end) for end in block_ends)
+                + "};\n\n"
+            )
+
         header.write(
-            f"inline constexpr bn::array<const bn::string_view, {len(license_infos)}> LICENSE_CONTENTS = {{\n"
+            f"inline constexpr bn::array<const sys::compressed_text, {len(license_infos)}> LICENSE_CONTENTS = {{\n"
         )
-        for license_info in license_infos:
-            header.write(f'R"({license_info.content})",\n')
+        for idx, license_info in enumerate(license_infos):
+            header.write(
+                f"sys::compressed_text(LICENSE_DICTIONARY, LICENSE_DATA_{idx}, "
+                f"LICENSE_BLOCK_ENDS_{idx}, "
+                f"{sum(len(page) for page in license_info.pages)}),\n"
+            )
         header.write("};\n\n")
 
         header.write(f"}} // namespace {NAMESPACE}::gen\n")
 
+    total_bytes = compressed_bytes + len(dictionary)
+    print(
+        f"Licenses: {raw_bytes} bytes -> {total_bytes} bytes "
+        f"({compressed_bytes} bytes + {len(dictionary)} bytes dictionary), "
+        f"saved {raw_bytes - total_bytes} bytes ({1 - total_bytes / raw_bytes:.1%})"
+    )
+
 
-def write_miscs(license_folder_path: Path, build_folder_path: Path):
+def write_miscs(
+    license_folder_path: Path,
+    fonts_build_folder_path: Path,
+    thumbnail_folder_path: Path,
+    dmg_audio_folder_path: Path,
+    build_folder_path: Path,
+):
     try:
         build_folder_path.joinpath("include/gen").mkdir(parents=True, exist_ok=True)
         build_folder_path.joinpath("src").mkdir(parents=True, exist_ok=True)
@@ -82,7 +166,15 @@ def write_miscs(license_folder_path: Path, build_folder_path: Path):
         tools_path = Path(__file__).parent
         tools_mtime = max(p.stat().st_mtime for p in tools_path.glob("*.py"))
 
-        write_license_header(license_folder_path, build_folder_path, tools_mtime)
+        write_license_header(
+            license_folder_path, fonts_build_folder_path, build_folder_path, tools_mtime
+        )
+        thumbnail_writer.write_thumbnail_headers(
+            thumbnail_folder_path, dmg_audio_folder_path, build_folder_path, tools_mtime
+        )
+        tune_analyzer.write_tune_metadata_header(
+            dmg_audio_folder_path, build_folder_path, tools_mtime
+        )
 
     except:
         remove_built_files(build_folder_path)
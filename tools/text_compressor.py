@@ -0,0 +1,166 @@
+"""Compresses texts for `sys::compressed_text`.
+
+Each text is split into blocks (pages of `text_paginator.py`), which are compressed
+with LZ77-style coding that refers to a static dictionary shared by every text, so
+that any block can be decompressed on its own.
+
+Token format:
+* `0LLLLLLL`, then `L + 1` literal bytes.
+* `1LLLLLLL DDDDDDDD DDDDDDDD`, which copies `L + MIN_MATCH_LENGTH` bytes from
+  `D + 1` (little endian) bytes behind. Bytes before the block are the end of the
+  dictionary.
+"""
+
+from typing import Dict, Final, List, Tuple
+import re
+
+MAX_BLOCK_BYTES: Final[int] = 1024
+MAX_DICTIONARY_BYTES: Final[int] = 8192
+
+MIN_MATCH_LENGTH: Final[int] = 4
+MAX_MATCH_LENGTH: Final[int] = MIN_MATCH_LENGTH + 0x7F
+MAX_MATCH_DISTANCE: Final[int] = 0x10000
+MAX_LITERALS: Final[int] = 0x80
+MAX_CHAIN: Final[int] = 64
+
+MIN_DICTIONARY_SEGMENT_BYTES: Final[int] = 12
+MIN_DICTIONARY_WORD_BYTES: Final[int] = 5
+MIN_DICTIONARY_WORD_COUNT: Final[int] = 3
+
+
+def build_dictionary(
+    texts: List[bytes], max_bytes: int = MAX_DICTIONARY_BYTES
+) -> bytes:
+    """Collects the repeated lines and sentences, and then the frequent words.
+
+    Candidates which save the most bytes come first.
+    """
+
+    corpus = b"\0".join(texts)
+    dictionary = bytearray()
+
+    def fill(scored: List[Tuple[int, bytes]], separator: bytes):
+        for _, candidate in sorted(scored, reverse=True):
+            if candidate in dictionary:
+                continue
+            if len(dictionary) + len(candidate) + len(separator) > max_bytes:
+                continue
+            dictionary.extend(candidate + separator)
+
+    segments = {
+        segment.strip()
+        for text in texts
+        for segment in re.split(rb"\n|(?<=\.) ", text)
+        if len(segment.strip()) >= MIN_DICTIONARY_SEGMENT_BYTES
+    }
+    segment_scores: List[Tuple[int, bytes]] = []
+    for segment in segments:
+        count = corpus.count(segment)
+        if count >= 2:
+            segment_scores.append(((count - 1) * len(segment), segment))
+    fill(segment_scores, b"\n")
+
+    word_counts: Dict[bytes, int] = {}
+    for word in re.findall(rb"[A-Za-z]{%d,}" % MIN_DICTIONARY_WORD_BYTES, corpus):
+        word_counts[word] = word_counts.get(word, 0) + 1
+    fill(
+        [
+            ((count - 1) * len(word), word)
+            for word, count in word_counts.items()
+            if count >= MIN_DICTIONARY_WORD_COUNT
+        ],
+        b" ",
+    )
+
+    return bytes(dictionary)
+
+
+def compress_block(block: bytes, dictionary: bytes) -> bytes:
+    assert len(block) <= MAX_BLOCK_BYTES
+    history = dictionary + block
+    out = bytearray()
+    literals = bytearray()
+
+    # Positions of each `MIN_MATCH_LENGTH` bytes prefix, newest last.
+    chains: Dict[bytes, List[int]] = {}
+
+    def insert(pos: int):
+        if pos + MIN_MATCH_LENGTH <= len(history):
+            chain = chains.setdefault(history[pos : pos + MIN_MATCH_LENGTH], [])
+            chain.append(pos)
+            if len(chain) > MAX_CHAIN:
+                del chain[0]
+
+    def flush_literals():
+        for start in range(0, len(literals), MAX_LITERALS):
+            chunk = literals[start : start + MAX_LITERALS]
+            out.append(len(chunk) - 1)
+            out.extend(chunk)
+        literals.clear()
+
+    for pos in range(len(dictionary)):
+        insert(pos)
+
+    pos = len(dictionary)
+    while pos < len(history):
+        best_length = 0
+        best_distance = 0
+        max_length = min(MAX_MATCH_LENGTH, len(history) - pos)
+        for candidate in reversed(
+            chains.get(history[pos : pos + MIN_MATCH_LENGTH], [])
+        ):
+            if pos - candidate > MAX_MATCH_DISTANCE:
+                break
+            length = 0
+            while (
+                length < max_length
+                and history[candidate + length] == history[pos + length]
+            ):
+                length += 1
+            if length > best_length:
+                best_length = length
+                best_distance = pos - candidate
+                if length == max_length:
+                    break
+
+        if best_length >= MIN_MATCH_LENGTH:
+            flush_literals()
+            encoded_distance = best_distance - 1
+            out.append(0x80 | (best_length - MIN_MATCH_LENGTH))
+            out.append(encoded_distance & 0xFF)
+            out.append(encoded_distance >> 8)
+            for _ in range(best_length):
+                insert(pos)
+                pos += 1
+        else:
+            literals.append(history[pos])
+            insert(pos)
+            pos += 1
+
+    flush_literals()
+    return bytes(out)
+
+
+def decompress_block(data: bytes, dictionary: bytes) -> bytes:
+    """Same as `sys::compressed_text::decompress_block()`, to check the output."""
+
+    out = bytearray()
+    pos = 0
+    while pos < len(data):
+        token = data[pos]
+        pos += 1
+        if token & 0x80:
+            length = (token & 0x7F) + MIN_MATCH_LENGTH
+            distance = (data[pos] | (data[pos + 1] << 8)) + 1
+            pos += 2
+            for _ in range(length):
+                src = len(out) - distance
+                out.append(
+                    out[src] if src >= 0 else dictionary[len(dictionary) + src]
+                )
+        else:
+            length = token + 1
+            out.extend(data[pos : pos + length])
+            pos += length
+
+    return bytes(out)
@@ -0,0 +1,116 @@
+"""Wraps and paginates texts for the butano sprite fonts at build time.
+
+The wrapped lines are separated with explicit newlines, so the text generator
+never has to wrap them again on the device.
+"""
+
+from pathlib import Path
+from typing import Dict, Final, List
+import re
+
+# butano sprite fonts start with the ASCII characters from ' ' to '~',
+# which are followed by the UTF-8 characters of the font.
+ASCII_CHARACTERS: Final[str] = "".join(chr(code) for code in range(ord(" "), 0x7F))
+
+
+def read_sprite_font_widths(font_header_path: Path) -> Dict[str, int]:
+    """Reads the character widths of a sprite font header from the fonts tool."""
+
+    with open(font_header_path, encoding="utf-8") as font_header:
+        source = font_header.read()
+
+    characters_match = re.search(
+        r"_utf8_characters\[\]\s*=\s*\{(.*?)\};", source, re.DOTALL
+    )
+    widths_match = re.search(
+        r"_character_widths\[\]\s*=\s*\{(.*?)\};", source, re.DOTALL
+    )
+    if widths_match is None:
+        raise ValueError(f"No character widths in `{font_header_path}`")
+
+    characters = list(ASCII_CHARACTERS)
+    if characters_match is not None:
+        for literal in re.findall(r'"((?:[^"\\]|\\.)*)"', characters_match.group(1)):
+            characters.append(re.sub(r"\\(.)", r"\1", literal))
+
+    widths = [
+        int(width, 0) for width in re.findall(r"-?\w+", widths_match.group(1))
+    ]
+    if len(widths) != len(characters):
+        raise ValueError(
+            f"{len(widths)} widths for {len(characters)} characters "
+            f"in `{font_header_path}`"
+        )
+
+    return dict(zip(characters, widths))
+
+
+def wrap_lines(text: str, widths: Dict[str, int], max_width: int) -> List[str]:
+    """Wraps the text on spaces, and splits the words wider than a line."""
+
+    def width_of(string: str) -> int:
+        try:
+            return sum(widths[character] for character in string)
+        except KeyError as ex:
+            raise ValueError(f"Character {ex} is not in the font") from None
+
+    lines: List[str] = []
+    for paragraph in text.split("\n"):
+        line = ""
+        line_width = 0
+        for word in re.findall(r"\S+|\s+", paragraph):
+            word_width = width_of(word)
+            if line_width + word_width <= max_width:
+                line += word
+                line_width += word_width
+            elif word.isspace():
+                # Spaces at the line break are dropped.
+                lines.append(line)
+                line = ""
+                line_width = 0
+            else:
+                if line:
+                    lines.append(line.rstrip())
+                line = ""
+                line_width = 0
+                for character in word:
+                    character_width = width_of(character)
+                    if line and line_width + character_width > max_width:
+                        lines.append(line)
+                        line = ""
+                        line_width = 0
+                    line += character
+                    line_width += character_width
+        lines.append(line.rstrip())
+
+    return lines
+
+
+def paginate(
+    text: str, widths: Dict[str, int], max_width: int, max_lines: int, max_bytes: int
+) -> List[bytes]:
+    """Splits the text into UTF-8 encoded pages of `max_lines` wrapped lines.
+
+    A page is cut short if the next line would overflow `max_bytes`.
+    """
+
+    pages: List[bytes] = []
+    page: List[bytes] = []
+    page_bytes = 0
+    for line in wrap_lines(text.rstrip("\n"), widths, max_width):
+        encoded = line.encode("utf-8")
+        # Newline before every line but the first one.
+        line_bytes = len(encoded) + (1 if page else 0)
+        if len(encoded) > max_bytes:
+            raise ValueError(f"Line of {len(encoded)} bytes doesn't fit in a page")
+        if len(page) == max_lines or page_bytes + line_bytes > max_bytes:
+            pages.append(b"\n".join(page))
+            page = []
+            page_bytes = 0
+            line_bytes = len(encoded)
+        page.append(encoded)
+        page_bytes += line_bytes
+    if page:
+        pages.append(b"\n".join(page))
+
+    return pages
@@ -0,0 +1,459 @@
+from pathlib import Path
+from typing import Dict, Final, List, Optional, Tuple
+from dataclasses import dataclass
+from datetime import datetime
+import struct
+
+import gba_compress
+
+NAMESPACE: Final[str] = "jb"
+
+# `bn::bitmap_bg::dp_direct_height()`, which the thumbnail is cropped to.
+THUMBNAIL_SIZE: Final[int] = 128
+
+MAX_PALETTE_COLORS: Final[int] = 256
+
+# Estimated ARM7 cycles per decompressed byte of `sys::bitmap_streamer`.
+# Uncompressed bitmap is streamed without copying.
+DECODE_CYCLES_PER_BYTE: Final[Dict[str, int]] = {
+    "NONE": 0,
+    "RUN_LENGTH": 10,
+    "LZ77": 20,
+    "HUFFMAN": 80,
+}
+
+# Faster codec is picked over the smallest one, if it's at most this much bigger.
+SIZE_TOLERANCE: Final[float] = 0.125
+
+Rgb = Tuple[int, int, int]
+
+# BGR555 color, as `bn::color` stores it.
+Color = int
+
+
+@dataclass
+class Bitmap:
+    width: int
+    height: int
+    pixels: List[Rgb]
+
+
+@dataclass
+class IndexedBitmap:
+    width: int
+    height: int
+    palette: List[Color]
+    indexes: bytes
+
+
+@dataclass
+class EncodedThumbnail:
+    indexed: IndexedBitmap
+    compression: str
+    data: bytes
+    sizes: Dict[str, int]
+
+
+def to_color(rgb: Rgb) -> Color:
+    r, g, b = rgb
+    return (r >> 3) | ((g >> 3) << 5) | ((b >> 3) << 10)
+
+
+def color_channels(color: Color) -> Tuple[int, int, int]:
+    return (color & 0x1F, (color >> 5) & 0x1F, (color >> 10) & 0x1F)
+
+
+def read_bmp(bmp_path: Path) -> Bitmap:
+    """Reads an uncompressed 1/4/8/24/32 bpp BMP file."""
+
+    data = bmp_path.read_bytes()
+    if data[0:2] != b"BM":
+        raise ValueError(f"Not a BMP file: {bmp_path}")
+
+    pixels_offset: int = struct.unpack_from("<I", data, 10)[0]
+    header_size: int = struct.unpack_from("<I", data, 14)[0]
+    width: int
+    height: int
+    bpp: int
+    compression: int
+    width, height, _, bpp, compression = struct.unpack_from("<iiHHI", data, 18)
+    if compression != 0:
+        raise ValueError(f"Compressed BMP is not supported: {bmp_path}")
+
+    bottom_up = height > 0
+    height = abs(height)
+
+    palette: List[Rgb] = []
+    if bpp <= 8:
+        palette_offset = 14 + header_size
+        for i in range((pixels_offset - palette_offset) // 4):
+            b, g, r, _ = data[palette_offset + i * 4 : palette_offset + i * 4 + 4]
+            palette.append((r, g, b))
+    elif bpp not in (24, 32):
+        raise ValueError(f"Unsupported BMP bpp {bpp}: {bmp_path}")
+
+    row_bytes = (width * bpp + 31) // 32 * 4
+    pixels: List[Rgb] = []
+    for y in range(height):
+        row_y = height - 1 - y if bottom_up else y
+        row_offset = pixels_offset + row_y * row_bytes
+        row = data[row_offset : row_offset + row_bytes]
+        for x in range(width):
+            if bpp <= 8:
+                bit = x * bpp
+                index = (row[bit // 8] >> (8 - bpp - bit % 8)) & ((1 << bpp) - 1)
+                pixels.append(palette[index])
+            else:
+                pixel_bytes = bpp // 8
+                b, g, r = row[x * pixel_bytes : x * pixel_bytes + 3]
+                pixels.append((r, g, b))
+
+    return Bitmap(width, height, pixels)
+
+
+def resize(bitmap: Bitmap, width: int, height: int) -> Bitmap:
+    """Shrinks the bitmap, averaging the source pixels of each pixel."""
+
+    pixels: List[Rgb] = []
+    for y in range(height):
+        y0 = y * bitmap.height // height
+        y1 = max(y0 + 1, (y + 1) * bitmap.height // height)
+        for x in range(width):
+            x0 = x * bitmap.width // width
+            x1 = max(x0 + 1, (x + 1) * bitmap.width // width)
+
+            sums = [0, 0, 0]
+            for src_y in range(y0, y1):
+                for src_x in range(x0, x1):
+                    pixel = bitmap.pixels[src_y * bitmap.width + src_x]
+                    for ch in range(3):
+                        sums[ch] += pixel[ch]
+            count = (y1 - y0) * (x1 - x0)
+            pixels.append(
+                (
+                    round(sums[0] / count),
+                    round(sums[1] / count),
+                    round(sums[2] / count),
+                )
+            )
+
+    return Bitmap(width, height, pixels)
+
+
+def crop(bitmap: Bitmap, x: int, y: int, width: int, height: int) -> Bitmap:
+    pixels: List[Rgb] = []
+    for row_y in range(y, y + height):
+        row_offset = row_y * bitmap.width + x
+        pixels.extend(bitmap.pixels[row_offset : row_offset + width])
+
+    return Bitmap(width, height, pixels)
+
+
+def fit_thumbnail(bitmap: Bitmap, size: int = THUMBNAIL_SIZE) -> Bitmap:
+    """Shrinks the bitmap to cover `size` x `size`, and crops the center of it.
+
+    Smaller bitmaps aren't enlarged, as the jukebox centers them.
+    """
+
+    scale = max(size / bitmap.width, size / bitmap.height)
+    if scale < 1:
+        bitmap = resize(
+            bitmap,
+            max(size, round(bitmap.width * scale)),
+            max(size, round(bitmap.height * scale)),
+        )
+
+    width = min(size, bitmap.width)
+    height = min(size, bitmap.height)
+    if (width, height) != (bitmap.width, bitmap.height):
+        x = (bitmap.width - width) // 2
+        y = (bitmap.height - height) // 2
+        bitmap = crop(bitmap, x, y, width, height)
+
+    return bitmap
+
+
+def median_cut(color_counts: Dict[Color, int], max_colors: int) -> List[Color]:
+    """Splits the color space by the median of the widest channel.
+
+    Medians are weighted by the pixel counts.
+    """
+
+    boxes: List[List[Color]] = [list(color_counts)]
+
+    while len(boxes) < max_colors:
+        # Split the box which has the most pixels, among the splittable ones.
+        splittable = [box for box in boxes if len(box) > 1]
+        if not splittable:
+            break
+        box = max(splittable, key=lambda b: sum(color_counts[c] for c in b))
+        boxes.remove(box)
+
+        ranges = [
+            max(color_channels(c)[ch] for c in box)
+            - min(color_channels(c)[ch] for c in box)
+            for ch in range(3)
+        ]
+        channel = ranges.index(max(ranges))
+        box.sort(key=lambda c: color_channels(c)[channel])
+
+        half = sum(color_counts[c] for c in box) / 2
+        accum = 0
+        split = 1
+        for i, c in enumerate(box[:-1]):
+            accum += color_counts[c]
+            split = i + 1
+            if accum >= half:
+                break
+
+        boxes.append(box[:split])
+        boxes.append(box[split:])
+
+    palette: List[Color] = []
+    for box in boxes:
+        total = sum(color_counts[c] for c in box)
+        averages = [
+            round(sum(color_channels(c)[ch] * color_counts[c] for c in box) / total)
+            for ch in range(3)
+        ]
+        palette.append(averages[0] | (averages[1] << 5) | (averages[2] << 10))
+
+    return palette
+
+
+def nearest_index(palette: List[Color], color: Color) -> int:
+    r, g, b = color_channels(color)
+
+    def distance(index: int) -> int:
+        pr, pg, pb = color_channels(palette[index])
+        return (pr - r) ** 2 + (pg - g) ** 2 + (pb - b) ** 2
+
+    return min(range(len(palette)), key=distance)
+
+
+def quantize(bitmap: Bitmap, max_colors: int = MAX_PALETTE_COLORS) -> IndexedBitmap:
+    """Quantizes the bitmap to a palette of up to `max_colors` BGR555 colors.
+
+    Bitmaps which already have few enough colors are converted without loss.
+    """
+
+    colors = [to_color(pixel) for pixel in bitmap.pixels]
+
+    color_counts: Dict[Color, int] = {}
+    for color in colors:
+        color_counts[color] = color_counts.get(color, 0) + 1
+
+    if len(color_counts) <= max_colors:
+        # Most used colors first.
+        palette = sorted(color_counts, key=lambda c: -color_counts[c])
+    else:
+        palette = median_cut(color_counts, max_colors)
+
+    index_of: Dict[Color, int] = {
+        color: nearest_index(palette, color) for color in color_counts
+    }
+    indexes = bytes(index_of[color] for color in colors)
+
+    return IndexedBitmap(bitmap.width, bitmap.height, palette, indexes)
+
+
+def encode_thumbnail(bitmap: Bitmap) -> EncodedThumbnail:
+    """Quantizes the thumbnail, and compresses it with every codec to pick one.
+
+    Smallest codec is picked, unless a faster one is within `SIZE_TOLERANCE` of it.
+    """
+
+    indexed = quantize(fit_thumbnail(bitmap))
+
+    candidates: Dict[str, bytes] = {
+        "NONE": indexed.indexes,
+        "RUN_LENGTH": gba_compress.compress_run_length(indexed.indexes),
+        "LZ77": gba_compress.compress_lz77(indexed.indexes),
+    }
+    symbol_bits = 4 if len(indexed.palette) <= 16 else 8
+    huffman: Optional[bytes] = gba_compress.compress_huffman(
+        indexed.indexes, symbol_bits
+    )
+    if huffman is not None:
+        candidates["HUFFMAN"] = huffman
+
+    sizes = {codec: len(data) for codec, data in candidates.items()}
+    max_size = min(sizes.values()) * (1 + SIZE_TOLERANCE)
+    compression = min(
+        (codec for codec, size in sizes.items() if size <= max_size),
+        key=lambda codec: (DECODE_CYCLES_PER_BYTE[codec], sizes[codec]),
+    )
+
+    return EncodedThumbnail(indexed, compression, candidates[compression], sizes)
+
+
+def to_identifier(name: str) -> str:
+    """C++ identifier of the file stem, e.g. `my-tune` to `my_tune`."""
+
+    return name.replace("-", "_")
+
+
+def thumbnail_item_header_path(build_folder_path: Path, name: str) -> Path:
+    return build_folder_path.joinpath(f"include/gen/thumbnail_items_{name}.h")
+
+
+def write_thumbnail_item_header(
+    thumbnail_path: Path, build_folder_path: Path, tools_mtime: float
+) -> bool:
+    """Returns `True` if the header is written, `False` if it's up to date."""
+
+    name = thumbnail_path.stem
+    header_path = thumbnail_item_header_path(build_folder_path, name)
+    identifier = to_identifier(name)
+
+    if (
+        header_path.exists()
+        and thumbnail_path.stat().st_mtime < header_path.stat().st_mtime
+        and tools_mtime < header_path.stat().st_mtime
+    ):
+        return False
+
+    encoded = encode_thumbnail(read_bmp(thumbnail_path))
+    indexed = encoded.indexed
+
+    sizes_text = ", ".join(f"{codec} {size}" for codec, size in encoded.sizes.items())
+    print(
+        f"Thumbnail {thumbnail_path.name}: {indexed.width}x{indexed.height}, "
+        f"{len(indexed.palette)} colors, {encoded.compression} "
+        f"({sizes_text} bytes)"
+    )
+
+    with open(header_path, "w", encoding="utf-8") as header:
+        header.write(f"// Generated by `thumbnail_writer.py` in {datetime.now()}\n")
+        header.write("//\n")
+        header.write(
+            "// DO NOT edit this file directly - changes will be overwritten!\n\n"
+        )
+        header.write("#pragma once\n\n")
+
+        header.write('#include "sys/indexed_bitmap_item.h"\n')
+        header.write('#include "sys/thumbnail_item.h"\n\n')
+        header.write("#include <bn_color.h>\n")
+        header.write("#include <bn_compression_type.h>\n")
+        header.write("#include <bn_size.h>\n\n")
+        header.write("#include <cstdint>\n\n")
+
+        header.write(f"namespace {NAMESPACE}::gen::thumbnail_items\n")
+        header.write("{\n\n")
+
+        header.write(
+            f"// {indexed.width}x{indexed.height}, {len(indexed.palette)} colors, "
+            f"{encoded.compression}: {len(encoded.data)} bytes "
+            f"(uncompressed: {len(indexed.indexes)} bytes)\n"
+        )
+
+        header.write(
+            f"alignas(int) inline constexpr std::uint8_t {identifier}_indexes[] = {{\n"
+        )
+        for offset in range(0, len(encoded.data), 32):
+            row = encoded.data[offset : offset + 32]
+            header.write(",".join(f"{byte:#04x}" for byte in row) + ",\n")
+        header.write("};\n\n")
+
+        header.write(f"inline constexpr bn::color {identifier}_palette[] = {{\n")
+        for color in indexed.palette:
+            header.write(f"bn::color({color:#06x}),\n")
+        header.write("};\n\n")
+
+        header.write(
+            f"inline constexpr sys::thumbnail_item {identifier}("
+            f"sys::indexed_bitmap_item({identifier}_indexes, {identifier}_palette, "
+            f"bn::size({indexed.width}, {indexed.height}), "
+            f"bn::compression_type::{encoded.compression}));\n\n"
+        )
+
+        header.write(f"}} // namespace {NAMESPACE}::gen::thumbnail_items\n")
+
+    return True
+
+
+def write_thumbnail_headers(
+    thumbnail_folder_path: Path,
+    dmg_audio_folder_path: Path,
+    build_folder_path: Path,
+    tools_mtime: float,
+):
+    """Writes a header per thumbnail, and `gen/thumbnails.h` which maps tunes to them.
+
+    `thumbnails/<tune>.bmp` is the thumbnail of `dmg_audio/<tune>.*`.
+    Only the thumbnails that have changed are encoded again.
+    """
+
+    thumbnails_header_path = build_folder_path.joinpath("include/gen/thumbnails.h")
+
+    thumbnail_paths = (
+        sorted(thumbnail_folder_path.glob("*.bmp"))
+        if thumbnail_folder_path.is_dir()
+        else []
+    )
+    tune_names = sorted({path.stem for path in dmg_audio_folder_path.glob("*.*")})
+    thumbnail_names = [path.stem for path in thumbnail_paths]
+
+    for name in thumbnail_names:
+        if name not in tune_names:
+            print(f"Warning: thumbnail of unknown tune: {name}")
+
+    # Remove the headers of the removed thumbnails.
+    for header_path in build_folder_path.joinpath("include/gen").glob(
+        "thumbnail_items_*.h"
+    ):
+        if header_path.stem.removeprefix("thumbnail_items_") not in thumbnail_names:
+            header_path.unlink()
+
+    items_written = False
+    for thumbnail_path in thumbnail_paths:
+        if write_thumbnail_item_header(thumbnail_path, build_folder_path, tools_mtime):
+            items_written = True
+
+    # Folders' mtime changes when a thumbnail or a tune is added or removed.
+    src_mtime = max(
+        (
+            path.stat().st_mtime
+            for path in (thumbnail_folder_path, dmg_audio_folder_path)
+            if path.exists()
+        ),
+        default=0.0,
+    )
+
+    if (
+        not items_written
+        and thumbnails_header_path.exists()
+        and src_mtime < thumbnails_header_path.stat().st_mtime
+        and tools_mtime < thumbnails_header_path.stat().st_mtime
+    ):
+        return
+
+    with open(thumbnails_header_path, "w", encoding="utf-8") as header:
+        header.write(f"// Generated by `thumbnail_writer.py` in {datetime.now()}\n")
+        header.write("//\n")
+        header.write(
+            "// DO NOT edit this file directly - changes will be overwritten!\n\n"
+        )
+        header.write("#pragma once\n\n")
+
+        header.write('#include "sys/thumbnail_item.h"\n\n')
+        for name in thumbnail_names:
+            header.write(f'#include "gen/thumbnail_items_{name}.h"\n')
+        if thumbnail_names:
+            header.write("\n")
+
+        header.write(f"namespace {NAMESPACE}::gen::tune_thumbnails\n")
+        header.write("{\n\n")
+
+        for name in tune_names:
+            identifier = to_identifier(name)
+            target = (
+                f"&thumbnail_items::{identifier}"
+                if name in thumbnail_names
+                else "nullptr"
+            )
+            header.write(
+                f"inline constexpr const sys::thumbnail_item* {identifier} = {target};\n"
+            )
+
+        header.write(f"\n}} // namespace {NAMESPACE}::gen::tune_thumbnails\n")
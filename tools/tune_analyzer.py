@@ -0,0 +1,525 @@
+"""Analyzes the tracker modules in `dmg_audio/` at build time for `sys::tune_metadata`.
+
+Each module is played through without sound, from the first order until it stops
+or comes back to a position it has already played, which is its loop point.
+
+Supported modules:
+* hUGETracker `.uge` version 6.
+* Furnace Tracker `.fur` (version 157 or later) with only Game Boy chips.
+"""
+
+from pathlib import Path
+from typing import Callable, Dict, Final, List, Optional, Tuple
+from dataclasses import dataclass, field
+from datetime import datetime
+from fractions import Fraction
+import struct
+import zlib
+
+NAMESPACE: Final[str] = "jb"
+
+# `sys::tune_metadata::CHANNELS_COUNT`
+CHANNELS_COUNT: Final[int] = 4
+
+# Game Boy vertical blank rate, which the trackers tick on by default.
+DMG_FRAME_RATE: Final[Fraction] = Fraction(4194304, 70224)
+
+# `bn::fixed` fraction bits.
+FIXED_PRECISION: Final[int] = 12
+
+# Give up on the modules which don't repeat in this many rows.
+MAX_SIMULATED_ROWS: Final[int] = 1 << 20
+
+UGE_VERSION: Final[int] = 6
+UGE_INSTRUMENTS_COUNT: Final[int] = 3 * 15
+UGE_INSTRUMENT_BYTES: Final[int] = 1385
+UGE_WAVES_BYTES: Final[int] = 16 * 32
+UGE_ROUTINES_COUNT: Final[int] = 16
+UGE_PATTERN_ROWS: Final[int] = 64
+UGE_CELL_FORMAT: Final[str] = "<IIIIB"
+UGE_EMPTY_NOTE: Final[int] = 90
+UGE_FX_POSITION_JUMP: Final[int] = 0xB
+UGE_FX_PATTERN_BREAK: Final[int] = 0xD
+UGE_FX_SET_SPEED: Final[int] = 0xF
+
+FUR_MAGIC: Final[bytes] = b"-Furnace module-"
+FUR_MIN_VERSION: Final[int] = 157
+FUR_GAME_BOY_CHIP: Final[int] = 0x04
+FUR_MAX_CHIPS: Final[int] = 32
+FUR_NOTE_OFF: Final[int] = 180
+FUR_FX_GROOVE: Final[int] = 0x09
+FUR_FX_POSITION_JUMP: Final[int] = 0x0B
+FUR_FX_PATTERN_BREAK: Final[int] = 0x0D
+FUR_FX_SPEED: Final[int] = 0x0F
+FUR_FX_STOP: Final[int] = 0xFF
+# Tick rate changes can't be represented with a single tick rate.
+FUR_FX_TICK_RATES: Final[Tuple[int, ...]] = (0xC0, 0xC1, 0xC2, 0xC3, 0xF0)
+
+Speeds = Tuple[int, ...]
+
+# Takes the speed pattern and its index, and returns the changed ones.
+SpeedEffect = Callable[[Speeds, int], Tuple[Speeds, int]]
+
+
+@dataclass
+class Row:
+    """Cells of every channel in a row, which only keep what affects the analysis."""
+
+    note_channels: List[int] = field(default_factory=list)
+    speed_effects: List[SpeedEffect] = field(default_factory=list)
+    jump_order: Optional[int] = None
+    break_row: Optional[int] = None
+    stop: bool = False
+
+
+@dataclass
+class Song:
+    tick_rate: Fraction
+    # Ticks of each row cycle through them.
+    speeds: Speeds
+    # Ticks per a speed unit, other than 1 with Furnace virtual tempo or time base.
+    speed_ticks: Fraction
+    orders: List[List[Row]]
+
+
+@dataclass
+class SeekPoint:
+    """Start of the rows played in a row with the same ticks, until the next jump, order
+    or speed change."""
+
+    ticks: int
+    order: int
+    row: int
+    rows_count: int = 0
+
+
+@dataclass
+class TuneMetadata:
+    total_ticks: int
+    # `None` if the tune stops by itself.
+    loop_start_ticks: Optional[int]
+    tick_rate: Fraction
+    channel_notes: List[int]
+    peak_rows_per_minute: int
+    seek_points: List[SeekPoint]
+
+
+class Reader:
+    def __init__(self, data: bytes, offset: int = 0):
+        self.data = data
+        self.offset = offset
+
+    def unpack(self, fmt: str) -> tuple:
+        values = struct.unpack_from(fmt, self.data, self.offset)
+        self.offset += struct.calcsize(fmt)
+        return values
+
+    def u8(self) -> int:
+        return self.unpack("<B")[0]
+
+    def u16(self) -> int:
+        return self.unpack("<H")[0]
+
+    def u32(self) -> int:
+        return self.unpack("<I")[0]
+
+    def f32(self) -> float:
+        return self.unpack("<f")[0]
+
+    def bytes(self, count: int) -> bytes:
+        self.offset += count
+        return self.data[self.offset - count : self.offset]
+
+    def skip(self, count: int):
+        self.offset += count
+
+    def c_string(self) -> str:
+        end = self.data.index(b"\0", self.offset)
+        string = self.data[self.offset : end].decode("utf-8", errors="replace")
+        self.offset = end + 1
+        return string
+
+
+def read_uge(data: bytes) -> Song:
+    reader = Reader(data)
+    version = reader.u32()
+    if version != UGE_VERSION:
+        raise ValueError(f"Unsupported hUGETracker version {version}")
+
+    # Name, artist and comment are pascal short strings.
+    reader.skip(3 * 256)
+    reader.skip(UGE_INSTRUMENTS_COUNT * UGE_INSTRUMENT_BYTES + UGE_WAVES_BYTES)
+
+    ticks_per_row = reader.u32()
+    timer_tempo_enabled = reader.u8() != 0
+    timer_divider = reader.u32()
+    tick_rate = (
+        Fraction(4096, 256 - timer_divider) if timer_tempo_enabled else DMG_FRAME_RATE
+    )
+
+    patterns: Dict[int, List[Tuple[int, ...]]] = {}
+    for _ in range(reader.u32()):
+        index = reader.u32()
+        patterns[index] = [
+            reader.unpack(UGE_CELL_FORMAT) for _ in range(UGE_PATTERN_ROWS)
+        ]
+
+    # Each channel has its own order list, whose last entry is unused.
+    channel_orders: List[List[int]] = []
+    for _ in range(CHANNELS_COUNT):
+        count = reader.u32()
+        channel_orders.append(list(reader.unpack(f"<{count}I"))[:-1])
+
+    for _ in range(UGE_ROUTINES_COUNT):
+        reader.skip(reader.u32())
+    if reader.offset != len(data):
+        raise ValueError(f"{len(data) - reader.offset} bytes left after the routines")
+
+    orders: List[List[Row]] = []
+    for order in range(len(channel_orders[0])):
+        rows = [Row() for _ in range(UGE_PATTERN_ROWS)]
+        for channel in range(CHANNELS_COUNT):
+            cells = patterns[channel_orders[channel][order]]
+            for row, (note, _, _, effect, param) in zip(rows, cells):
+                if note != UGE_EMPTY_NOTE:
+                    row.note_channels.append(channel)
+                # hUGEDriver keeps the jump targets 1-based, so that 0 is no jump.
+                if effect == UGE_FX_POSITION_JUMP and param > 0:
+                    row.jump_order = param - 1
+                elif effect == UGE_FX_PATTERN_BREAK and param > 0:
+                    row.break_row = param - 1
+                elif effect == UGE_FX_SET_SPEED and param > 0:
+                    row.speed_effects.append(lambda _s, _i, p=param: ((p,), 0))
+        orders.append(rows)
+
+    return Song(tick_rate, (ticks_per_row,), Fraction(1), orders)
+
+
+def read_fur(data: bytes) -> Song:
+    if not data.startswith(FUR_MAGIC):
+        data = zlib.decompress(data)
+    if not data.startswith(FUR_MAGIC):
+        raise ValueError("Not a Furnace module")
+
+    reader = Reader(data, len(FUR_MAGIC))
+    version = reader.u16()
+    if version < FUR_MIN_VERSION:
+        raise ValueError(f"Furnace version {version} is too old, save it again")
+    reader.skip(2)
+    reader.offset = reader.u32()
+
+    if reader.bytes(4) != b"INFO":
+        raise ValueError("No song info block")
+    reader.skip(4)
+
+    time_base, speed_1, speed_2 = reader.unpack("<BBB")
+    reader.skip(1)
+    tick_rate = Fraction(reader.f32()).limit_denominator(1000)
+    pattern_rows = reader.u16()
+    orders_count = reader.u16()
+    reader.skip(2)
+    instruments_count = reader.u16()
+    waves_count = reader.u16()
+    samples_count = reader.u16()
+    patterns_count = reader.u32()
+
+    chips = [chip for chip in reader.bytes(FUR_MAX_CHIPS) if chip != 0]
+    if any(chip != FUR_GAME_BOY_CHIP for chip in chips):
+        raise ValueError(f"Non Game Boy chips: {chips}")
+    channels_count = CHANNELS_COUNT * len(chips)
+
+    # Chip volumes, panning and flags, song name and author, A-4 tuning and compat flags
+    reader.skip(FUR_MAX_CHIPS * 2 + 4 * FUR_MAX_CHIPS)
+    reader.c_string()
+    reader.c_string()
+    reader.skip(4 + 20)
+
+    reader.skip(4 * (instruments_count + waves_count + samples_count))
+    pattern_offsets = reader.unpack(f"<{patterns_count}I")
+    channel_orders = [list(reader.bytes(orders_count)) for _ in range(channels_count)]
+
+    # Effect columns, hide and collapse status, names and short names, song comment,
+    # master volume and extended compat flags
+    reader.skip(3 * channels_count)
+    for _ in range(2 * channels_count + 1):
+        reader.c_string()
+    reader.skip(4 + 28)
+
+    virtual_tempo_numerator = reader.u16()
+    virtual_tempo_denominator = reader.u16()
+
+    # Subsongs, metadata strings, chip mixing and patchbay, and more compat flags
+    reader.c_string()
+    reader.c_string()
+    reader.skip(3 + 4 * reader.u8())
+    for _ in range(6):
+        reader.c_string()
+    reader.skip(3 * 4 * len(chips))
+    reader.skip(4 * reader.u32() + 1 + 8)
+
+    speeds_length = reader.u8()
+    speeds = tuple(reader.bytes(16)[:speeds_length]) or (speed_1, speed_2)
+    grooves: List[Speeds] = []
+    for _ in range(reader.u8()):
+        length = reader.u8()
+        grooves.append(tuple(reader.bytes(16)[:length]))
+
+    def groove(value: int) -> SpeedEffect:
+        if not grooves:
+            return lambda s, i: ((value,) + s[1:], i)
+        return lambda s, i: (grooves[value], 0) if value < len(grooves) else (s, i)
+
+    def speed(value: int) -> SpeedEffect:
+        return lambda s, i: (
+            (s[0], value) if len(s) == 2 and not grooves else (value,) + s[1:],
+            i,
+        )
+
+    orders = [[Row() for _ in range(pattern_rows)] for _ in range(orders_count)]
+    # Row index, whether a note starts, and effects of each pattern
+    Cell = Tuple[int, bool, Dict[int, int]]
+    cells_of: Dict[Tuple[int, int], List[Cell]] = {}
+
+    for offset in pattern_offsets:
+        pattern = Reader(data, offset)
+        if pattern.bytes(4) != b"PATN":
+            raise ValueError(f"No pattern block at {offset:#x}")
+        pattern.skip(5)
+        channel = pattern.u8()
+        index = pattern.u16()
+        pattern.c_string()
+
+        cells: List[Cell] = []
+        row = 0
+        while (flags := pattern.u8()) != 0xFF:
+            if flags & 0x80:
+                row += (flags & 0x7F) + 2
+                continue
+
+            effect_flags = (flags >> 3) & 0b11
+            if flags & 0x20:
+                effect_flags |= pattern.u8()
+            if flags & 0x40:
+                effect_flags |= pattern.u8() << 8
+
+            note = pattern.u8() if flags & 0x01 else None
+            pattern.skip(((flags >> 1) & 1) + ((flags >> 2) & 1))
+
+            effects: Dict[int, int] = {}
+            for column in range(8):
+                effect = pattern.u8() if effect_flags & (1 << (2 * column)) else None
+                value = pattern.u8() if effect_flags & (2 << (2 * column)) else 0
+                if effect is not None:
+                    effects[effect] = value
+
+            cells.append((row, note is not None and note < FUR_NOTE_OFF, effects))
+            row += 1
+        cells_of[(channel, index)] = cells
+
+    for order, rows in enumerate(orders):
+        for channel in range(channels_count):
+            for row_index, note_on, effects in cells_of.get(
+                (channel, channel_orders[channel][order]), []
+            ):
+                if row_index >= pattern_rows:
+                    continue
+                row = rows[row_index]
+                # Notes of the chips after the first one go to the same channels.
+                if note_on:
+                    row.note_channels.append(channel % CHANNELS_COUNT)
+                for effect, value in effects.items():
+                    if effect in FUR_FX_TICK_RATES:
+                        raise ValueError(f"Unsupported tick rate effect {effect:02X}")
+                    if effect == FUR_FX_GROOVE:
+                        row.speed_effects.append(groove(value))
+                    elif effect == FUR_FX_SPEED and value > 0:
+                        row.speed_effects.append(speed(value))
+                    elif effect == FUR_FX_POSITION_JUMP:
+                        row.jump_order = value
+                    elif effect == FUR_FX_PATTERN_BREAK:
+                        row.break_row = value
+                    elif effect == FUR_FX_STOP:
+                        row.stop = True
+
+    speed_ticks = Fraction(
+        (time_base + 1) * virtual_tempo_denominator, virtual_tempo_numerator
+    )
+    return Song(tick_rate, speeds, speed_ticks, orders)
+
+
+def analyze_song(song: Song) -> TuneMetadata:
+    """Plays the song until it stops or reaches a position with the same speed state."""
+
+    visited: Dict[Tuple[int, int, Speeds, int], Fraction] = {}
+    ticks = Fraction(0)
+    loop_start_ticks: Optional[Fraction] = None
+    min_row_ticks: Optional[Fraction] = None
+    channel_notes = [0] * CHANNELS_COUNT
+    seek_points: List[SeekPoint] = []
+    seek_row_ticks: Optional[Fraction] = None
+
+    order = 0
+    row_index = 0
+    speeds = song.speeds
+    speed_index = 0
+    new_visit = True
+
+    for _ in range(MAX_SIMULATED_ROWS):
+        state = (order, row_index, speeds, speed_index)
+        if state in visited:
+            loop_start_ticks = visited[state]
+            break
+        visited[state] = ticks
+
+        row = song.orders[order][row_index]
+        if row.stop:
+            break
+
+        for channel in row.note_channels:
+            channel_notes[channel] += 1
+        for speed_effect in row.speed_effects:
+            speeds, speed_index = speed_effect(speeds, speed_index)
+
+        row_ticks = speeds[speed_index % len(speeds)] * song.speed_ticks
+
+        # Rows of a seek point take the same ticks, so that the row of a tick can be
+        # calculated at runtime, even with the grooves.
+        if new_visit or row_ticks != seek_row_ticks:
+            seek_points.append(SeekPoint(round(ticks), order, row_index))
+            seek_row_ticks = row_ticks
+        seek_points[-1].rows_count += 1
+
+        ticks += row_ticks
+        if min_row_ticks is None or row_ticks < min_row_ticks:
+            min_row_ticks = row_ticks
+        speed_index = (speed_index + 1) % len(speeds)
+
+        prev_order = order
+        new_visit = row.jump_order is not None or row.break_row is not None
+        if new_visit:
+            order = row.jump_order if row.jump_order is not None else order + 1
+            row_index = row.break_row if row.break_row is not None else 0
+        else:
+            row_index += 1
+
+        if row_index >= len(song.orders[order % len(song.orders)]):
+            order += 1
+            row_index = 0
+        if order >= len(song.orders):
+            order = 0
+            row_index = min(row_index, len(song.orders[0]) - 1)
+        new_visit = new_visit or order != prev_order
+    else:
+        raise ValueError(f"Song doesn't end or loop in {MAX_SIMULATED_ROWS} rows")
+
+    if min_row_ticks is None:
+        raise ValueError("Song stops before playing a row")
+
+    return TuneMetadata(
+        round(ticks),
+        None if loop_start_ticks is None else round(loop_start_ticks),
+        song.tick_rate,
+        channel_notes,
+        round(60 * song.tick_rate / min_row_ticks),
+        seek_points,
+    )
+
+
+def analyze_tune(tune_path: Path) -> TuneMetadata:
+    readers: Dict[str, Callable[[bytes], Song]] = {
+        ".uge": read_uge,
+        ".fur": read_fur,
+    }
+    reader = readers.get(tune_path.suffix.lower())
+    if reader is None:
+        raise ValueError(f"Unsupported module format: {tune_path}")
+
+    try:
+        return analyze_song(reader(tune_path.read_bytes()))
+    except (ValueError, IndexError, KeyError, struct.error, zlib.error) as ex:
+        raise ValueError(f"Can't analyze `{tune_path}`: {ex!r}") from None
+
+
+def format_time(ticks: int, tick_rate: Fraction) -> str:
+    tenths = round(ticks * 10 / tick_rate)
+    return f"{tenths // 600}:{tenths // 10 % 60:02}.{tenths % 10}"
+
+
+def write_tune_metadata_header(
+    dmg_audio_folder_path: Path, build_folder_path: Path, tools_mtime: float
+):
+    """Writes `gen/tune_metadata.h`, which has the metadata of `dmg_audio/<tune>.*`."""
+
+    header_path = build_folder_path.joinpath("include/gen/tune_metadata.h")
+
+    tune_paths = sorted(dmg_audio_folder_path.glob("*.*"))
+
+    # Folder's mtime changes when a tune is added or removed.
+    src_mtime = max(
+        [dmg_audio_folder_path.stat().st_mtime]
+        + [path.stat().st_mtime for path in tune_paths]
+    )
+
+    if (
+        header_path.exists()
+        and src_mtime < header_path.stat().st_mtime
+        and tools_mtime < header_path.stat().st_mtime
+    ):
+        return
+
+    metadatas = {path.stem: analyze_tune(path) for path in tune_paths}
+
+    with open(header_path, "w", encoding="utf-8") as header:
+        header.write(f"// Generated by `tune_analyzer.py` in {datetime.now()}\n")
+        header.write("//\n")
+        header.write(
+            "// DO NOT edit this file directly - changes will be overwritten!\n\n"
+        )
+        header.write("#pragma once\n\n")
+
+        header.write('#include "sys/tune_metadata.h"\n\n')
+        header.write("#include <bn_fixed.h>\n\n")
+
+        header.write(f"namespace {NAMESPACE}::gen::tune_metadata\n")
+        header.write("{\n\n")
+
+        for name, metadata in metadatas.items():
+            loop_text = (
+                "stops"
+                if metadata.loop_start_ticks is None
+                else "loops from "
+                + format_time(metadata.loop_start_ticks, metadata.tick_rate)
+            )
+            summary = (
+                f"{format_time(metadata.total_ticks, metadata.tick_rate)}, "
+                f"{loop_text}, {float(metadata.tick_rate):.2f} Hz"
+            )
+            print(f"Tune {name}: {summary}")
+
+            tick_rate_data = round(metadata.tick_rate * (1 << FIXED_PRECISION))
+            loop_start_ticks = (
+                -1 if metadata.loop_start_ticks is None else metadata.loop_start_ticks
+            )
+            header.write(f"// {summary}\n")
+
+            # Ticks, rows count, order and row
+            header.write(
+                f"inline constexpr sys::tune_metadata::seek_point {name}_seek_points[] = {{\n"
+            )
+            for point in metadata.seek_points:
+                if point.order > 0xFF or point.row > 0xFF or point.rows_count > 0xFFFF:
+                    raise ValueError(f"Seek point out of range in {name}: {point}")
+                header.write(
+                    f"{{{point.ticks}, {point.rows_count}, {point.order}, {point.row}}},\n"
+                )
+            header.write("};\n\n")
+
+            header.write(
+                f"inline constexpr sys::tune_metadata {name}("
+                f"{metadata.total_ticks}, {loop_start_ticks}, "
+                f"bn::fixed::from_data({tick_rate_data}), "
+                f"{{{', '.join(str(notes) for notes in metadata.channel_notes)}}}, "
+                f"{metadata.peak_rows_per_minute}, {name}_seek_points);\n\n"
+            )
+
+        header.write(f"}} // namespace {NAMESPACE}::gen::tune_metadata\n")